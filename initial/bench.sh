@@ -0,0 +1 @@
+g++ -O2 -I include -I src -std=c++17 -pthread src/bench/* src/bench_main.cpp -o bench -ltbb && ./bench "$@"
@@ -2,6 +2,7 @@
 #define INVENTORY_MANAGER_H
 
 #include "list/XArrayList.h"
+#include "list/CowArrayList.h"
 #include "list/DLinkedList.h"
 #include <sstream>
 #include <string>
@@ -12,11 +13,16 @@
 using namespace std;
 
 // -------------------- List1D --------------------
+// copies of a List1D (getRow, getProductAttributes, InventoryManager copies)
+// share the items until one of them changes: no item is copied
+template <typename T>
+using List1DStorage = CowArrayList<T>;
+
 template <typename T>
 class List1D
 {
 private:
-    IList<T> *pList;
+    List1DStorage<T> items;
 
 public:
     List1D();
@@ -127,17 +133,15 @@ template <typename T>
 List1D<T>::List1D()
 {
     // TODO
-    this->pList = new XArrayList<T>();
 }
 
 template <typename T>
 List1D<T>::List1D(int num_elements)
 {
     // TODO
-    pList = new XArrayList<T>();
     for (int i = 0; i < num_elements; i++)
     {
-        pList->add(T());
+        items.add(T());
     }
 }
 
@@ -145,46 +149,37 @@ template <typename T>
 List1D<T>::List1D(const T *array, int num_elements)
 {
     // TODO
-    pList = new XArrayList<T>();
     for (int i = 0; i < num_elements; i++)
     {
-        pList->add(array[i]);
+        items.add(array[i]);
     }
 }
 
 template <typename T>
 List1D<T>::List1D(const List1D<T> &other)
+    : items(other.items) // shares the items until one of the lists changes
 {
     // TODO
-    pList = new XArrayList<T>();
-    if (other.pList)
-    {
-        for (int i = 0; i < other.size(); i++)
-        {
-            pList->add(other.pList->get(i));
-        }
-    }
 }
 
 template <typename T>
 List1D<T>::~List1D()
 {
     // TODO
-    delete pList;
 }
 
 template <typename T>
 int List1D<T>::size() const
 {
     // TODO
-    return pList->size();
+    return items.size();
 }
 
 template <typename T>
 T List1D<T>::get(int index) const
 {
     // TODO
-    return pList->get(index);
+    return items.read(index);
 }
 
 template <typename T>
@@ -193,23 +188,22 @@ void List1D<T>::set(int index, T value)
     // TODO
     if (index < 0)
         throw out_of_range("Index is out of range!");
-    XArrayList<T> *pList = dynamic_cast<XArrayList<T> *>(this->pList);
-    pList->set(index, value);
+    items.set(index, value);
 }
 
 template <typename T>
 void List1D<T>::add(const T &value)
 {
     // TODO
-    pList->add(value);
+    items.add(value);
 }
 template <typename T>
 void List1D<T>::removeAt(int index)
 {
     // TODO
-    if (index < 0 || index >= pList->size())
+    if (index < 0 || index >= items.size())
         throw out_of_range("Index is out of range!");
-    pList->removeAt(index);
+    items.removeAt(index);
 }
 
 template <typename T>
@@ -218,12 +212,7 @@ List1D<T> &List1D<T>::operator=(const List1D<T> &other)
     // TODO
     if (this != &other)
     {
-        delete pList;
-        pList = new XArrayList<T>();
-        for (int i = 0; i < other.size(); i++)
-        {
-            pList->add(other.pList->get(i));
-        }
+        items = other.items;
     }
     return *this;
 }
@@ -234,10 +223,10 @@ string List1D<T>::toString() const
     // TODO
     ostringstream oss;
     oss << "[";
-    for (int i = 0; i < pList->size(); i++)
+    for (int i = 0; i < items.size(); i++)
     {
         oss << get(i);
-        if (i < pList->size() - 1)
+        if (i < items.size() - 1)
         {
             oss << ", ";
         }
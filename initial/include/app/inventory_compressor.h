@@ -11,6 +11,7 @@
 #include "hash/xMap.h"
 #include "heap/Heap.h"
 #include "list/XArrayList.h"
+#include "list/SmallList.h"
 
 //! thêm này vô để chạy test
 
@@ -19,16 +20,17 @@ template <int treeOrder>
 class HuffmanTree
 {
 public:
+    struct HuffmanNode;
+    // at most treeOrder children: kept inside the node, no allocation per node
+    typedef SmallList<HuffmanNode *, treeOrder> ChildList;
     struct HuffmanNode
     {
         char symbol;
         int freq;
-        XArrayList<HuffmanNode *> children;
+        ChildList children;
         int order;
-        HuffmanNode(char s, int f, int ord = 0) : symbol(s), freq(f), order(ord) {
-            children = XArrayList<HuffmanNode*>();
-        }
-        HuffmanNode(int f, const XArrayList<HuffmanNode*>& childs, int ord = 0) 
+        HuffmanNode(char s, int f, int ord = 0) : symbol(s), freq(f), order(ord) {}
+        HuffmanNode(int f, const ChildList& childs, int ord = 0) 
             : symbol('\0'), freq(f), children(childs), order(ord) {}
         bool operator<(const HuffmanNode &other) const
         {
@@ -150,7 +152,7 @@ void HuffmanTree<treeOrder>::build(XArrayList<pair<char, int>> &symbolsFreqs)
 
     while (minHeap.size() > 1)
     {
-        XArrayList<HuffmanNode *> children;
+        ChildList children;
         int totalFreq = 0;
         for (int i = 0; i < treeOrder && !minHeap.empty(); ++i)
         {
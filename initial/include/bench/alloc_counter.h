@@ -0,0 +1,27 @@
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+/*
+ * AllocCounter: statistics of the global operator new/delete of the bench binary
+ *      (replaced in src/bench/alloc_counter.cpp)
+ *  + allocations: calls to operator new / new[] (any alignment) since the last reset
+ *  + liveBytes: bytes allocated and not freed yet
+ *  + peakBytes: highest liveBytes since the last reset
+ *  Example:
+ *      AllocCounter::reset();
+ *      ... work ...
+ *      cout << AllocCounter::peakBytes() << endl;
+ */
+class AllocCounter
+{
+public:
+    static long long allocations();
+    static long long liveBytes();
+    static long long peakBytes();
+    /*
+     * reset(): allocations = 0, peakBytes = liveBytes
+     */
+    static void reset();
+};
+
+#endif /* ALLOC_COUNTER_H */
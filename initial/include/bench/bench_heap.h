@@ -0,0 +1,11 @@
+void benchHeapDijkstra(long long n);
+void benchHeapBulkBuild(long long n);
+void benchHeapTopK(long long n);
+void benchHeapKWayMerge(long long n);
+void benchHeapSort(long long n);
+void benchHeapMultiQueue(long long n);
+void benchHeapMeld(long long n);
+void benchHeapBlockLayout(long long n);
+void benchHeapExternal(long long n);
+void benchHeapTimers(long long n);
+void benchHeapSortedView(long long n);
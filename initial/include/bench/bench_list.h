@@ -0,0 +1,10 @@
+void benchListSegmentedAppend(long long n);
+void benchListBulkOps(long long n);
+void benchListSimdSearch(long long n);
+void benchListSmallAlloc(long long n);
+void benchListSort(long long n);
+void benchListAlgoScaling(long long n);
+void benchListGapEdits(long long n);
+void benchListConcurrentAppend(long long n);
+void benchListSnapshots(long long n);
+void benchListPacked(long long n);
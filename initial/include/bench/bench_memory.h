@@ -0,0 +1 @@
+void benchMemoryResources(long long n);
@@ -0,0 +1,51 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+using namespace std;
+
+/*
+ * Stopwatch: wall-clock timer used by all benchmarks
+ *  Example:
+ *      Stopwatch watch;
+ *      ... work ...
+ *      benchReport("heap.push", n, watch.elapsedMs());
+ */
+class Stopwatch
+{
+private:
+    chrono::steady_clock::time_point start;
+
+public:
+    Stopwatch()
+    {
+        reset();
+    }
+    void reset()
+    {
+        start = chrono::steady_clock::now();
+    }
+    double elapsedMs()
+    {
+        chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+};
+
+/*
+ * benchReport: print one line "name | n | time | throughput"
+ *      ops: number of operations done in "ms" milliseconds
+ */
+inline void benchReport(const string &name, long long ops, double ms)
+{
+    double mops = ms > 0 ? (ops / 1000.0) / ms : 0;
+    cout << "  " << setw(36) << left << name
+         << setw(12) << right << ops << " ops"
+         << setw(12) << fixed << setprecision(2) << ms << " ms"
+         << setw(10) << fixed << setprecision(2) << mops << " Mops/s" << endl;
+}
+
+#endif /* BENCH_UTIL_H */
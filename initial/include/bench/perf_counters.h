@@ -0,0 +1,129 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <iostream>
+#include <string>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+using namespace std;
+
+/*
+ * PerfCounters: hardware counters of the calling thread (Linux perf_event_open)
+ *      dTLB load misses, last-level cache misses
+ *  + a counter that cannot be opened (not Linux, no PMU in a VM,
+ *      perf_event_paranoid, ...) is reported as "n/a": the benchmark still runs
+ *  Example:
+ *      PerfCounters counters;
+ *      counters.start();
+ *      ... work ...
+ *      counters.stop();
+ *      counters.report();
+ */
+class PerfCounters
+{
+private:
+    static const int N_COUNTERS = 2;
+    int fds[N_COUNTERS];
+    long long values[N_COUNTERS];
+
+public:
+    PerfCounters()
+    {
+        for (int i = 0; i < N_COUNTERS; i++)
+        {
+            fds[i] = -1;
+            values[i] = -1;
+        }
+#ifdef __linux__
+        fds[0] = openCounter(PERF_TYPE_HW_CACHE,
+                             PERF_COUNT_HW_CACHE_DTLB |
+                                 (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                 (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+        fds[1] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+#endif
+    }
+    ~PerfCounters()
+    {
+#ifdef __linux__
+        for (int i = 0; i < N_COUNTERS; i++)
+            if (fds[i] != -1)
+                close(fds[i]);
+#endif
+    }
+    bool available()
+    {
+        for (int i = 0; i < N_COUNTERS; i++)
+            if (fds[i] != -1)
+                return true;
+        return false;
+    }
+    void start()
+    {
+#ifdef __linux__
+        for (int i = 0; i < N_COUNTERS; i++)
+            if (fds[i] != -1)
+            {
+                ioctl(fds[i], PERF_EVENT_IOC_RESET, 0);
+                ioctl(fds[i], PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+    }
+    void stop()
+    {
+#ifdef __linux__
+        for (int i = 0; i < N_COUNTERS; i++)
+        {
+            values[i] = -1;
+            if (fds[i] == -1)
+                continue;
+            ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+            long long value;
+            if (read(fds[i], &value, sizeof(value)) == sizeof(value))
+                values[i] = value;
+        }
+#endif
+    }
+    long long tlbMisses()
+    {
+        return values[0];
+    }
+    long long cacheMisses()
+    {
+        return values[1];
+    }
+    /*
+     * report(): one line under the benchReport line of the same work
+     */
+    void report()
+    {
+        cout << "    dTLB load misses: " << counterString(values[0])
+             << ", LLC misses: " << counterString(values[1]) << endl;
+    }
+
+private:
+    static string counterString(long long value)
+    {
+        return value < 0 ? "n/a" : to_string(value);
+    }
+#ifdef __linux__
+    static int openCounter(unsigned int type, unsigned long long config)
+    {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+#endif
+};
+
+#endif /* PERF_COUNTERS_H */
@@ -34,6 +34,7 @@ protected:
     bool (*valueEqual)(V &, V &);       // valueEqual(V& lhs, V& rhs): test if lhs == rhs
     void (*deleteKeys)(xMap<K, V> *);   // deleteKeys(xMap<K,V>* pMap): delete all keys stored in pMap
     void (*deleteValues)(xMap<K, V> *); // deleteValues(xMap<K,V>* pMap): delete all values stored in pMap
+    pmr::memory_resource *resource;     // memory of the table, its nodes and the entries (0: new/delete)
 
 public:
     xMap(
@@ -42,7 +43,8 @@ public:
         bool (*valueEqual)(V &, V &) = 0,
         void (*deleteValues)(xMap<K, V> *) = 0,
         bool (*keyEqual)(K &, K &) = 0,
-        void (*deleteKeys)(xMap<K, V> *) = 0);
+        void (*deleteKeys)(xMap<K, V> *) = 0,
+        pmr::memory_resource *resource = 0); // see util/MemoryResource.h
 
     xMap(const xMap<K, V> &map);                  // copy constructor
     xMap<K, V> &operator=(const xMap<K, V> &map); // assignment operator
@@ -156,6 +158,13 @@ protected:
     void moveEntries(
         DLinkedList<Entry *> *oldTable, int oldCapacity,
         DLinkedList<Entry *> *newTable, int newCapacity);
+    /*
+     * newTable(capacity): empty buckets; with a resource, their nodes use it too
+     */
+    DLinkedList<Entry *> *newTable(int capacity)
+    {
+        return newArray<DLinkedList<Entry *>>(resource, capacity, nullptr, nullptr, resource);
+    }
 
     /*
      * keyEQ(K& lhs, K& rhs): verify the equality of two keys
@@ -211,7 +220,8 @@ xMap<K, V>::xMap(
     bool (*valueEqual)(V &lhs, V &rhs),
     void (*deleteValues)(xMap<K, V> *),
     bool (*keyEqual)(K &lhs, K &rhs),
-    void (*deleteKeys)(xMap<K, V> *pMap))
+    void (*deleteKeys)(xMap<K, V> *pMap),
+    pmr::memory_resource *resource)
 {
     // YOUR CODE IS HERE
     if(!hashCode){
@@ -225,7 +235,8 @@ xMap<K, V>::xMap(
     this->deleteValues = deleteValues;
     this->keyEqual = keyEqual;
     this->deleteKeys = deleteKeys;
-    this->table = new DLinkedList<Entry *>[capacity];
+    this->resource = resource;
+    this->table = newTable(capacity);
 }
 
 template <class K, class V>
@@ -240,6 +251,7 @@ xMap<K, V>::xMap(const xMap<K, V> &map)
     this->deleteValues = nullptr;
     this->keyEqual = map.keyEqual;
     this->deleteKeys = nullptr;
+    this->resource = 0; // as std::pmr containers: a copy does not take the resource
     
     this->table = new DLinkedList<Entry *>[capacity]();
     for (int idx = 0; idx < capacity; idx++)
@@ -290,7 +302,7 @@ V xMap<K, V>::put(K key, V value)
         }
     }
     //add new entry if the key does not exist
-    Entry *newEntry = new Entry(key, value);
+    Entry *newEntry = newObject<Entry>(resource, key, value);
     list.add(newEntry);
     count++;
     ensureLoadFactor(count); // check if we need to rehash
@@ -326,7 +338,8 @@ V xMap<K, V>::remove(K key, void (*deleteKeyInMap)(K))
             if(deleteKeyInMap){
                 deleteKeyInMap(pEntry->key);
             }
-            list.removeItem(pEntry, deleteEntry);
+            list.removeItem(pEntry);
+            deleteObject(resource, pEntry);
             count--;
             return value;
         }
@@ -351,7 +364,8 @@ bool xMap<K, V>::remove(K key, V value, void (*deleteKeyInMap)(K), void (*delete
             if(deleteValueInMap){
                 deleteValueInMap(pEntry->value);
             }
-            list.removeItem(pEntry, &xMap<K,V>::deleteEntry);
+            list.removeItem(pEntry);
+            deleteObject(resource, pEntry);
             count--;
             return true;
         }
@@ -408,7 +422,7 @@ void xMap<K, V>::clear()
     removeInternalData();
     this->capacity = 10;
     this->count = 0;
-    this->table = new DLinkedList<Entry *>[capacity];   
+    this->table = newTable(capacity);
 }
 
 template <class K, class V>
@@ -555,7 +569,7 @@ void xMap<K, V>::rehash(int newCapacity)
     int oldCapacity = capacity;
 
     // Create new table:
-    this->table = new DLinkedList<Entry *>[newCapacity];
+    this->table = newTable(newCapacity);
     this->capacity = newCapacity; // keep "count" not changed
 
     moveEntries(pOldMap, oldCapacity, this->table, newCapacity);
@@ -567,7 +581,7 @@ void xMap<K, V>::rehash(int newCapacity)
         list.clear();
     }
     // Remove oldTable
-    delete[] pOldMap;
+    deleteArray(resource, pOldMap, oldCapacity);
 }
 
 /*
@@ -592,12 +606,12 @@ void xMap<K, V>::removeInternalData()
     {
         DLinkedList<Entry *> &list = this->table[idx];
         for (auto pEntry : list)
-            delete pEntry;
+            deleteObject(resource, pEntry);
         list.clear();
     }
 
     // Remove table
-    delete[] table;
+    deleteArray(resource, table, capacity);
 }
 
 /*
@@ -615,7 +629,7 @@ void xMap<K, V>::copyMapFrom(const xMap<K, V> &map)
 
     this->capacity = map.capacity;
     this->count = 0;
-    this->table = new DLinkedList<Entry *>[capacity];
+    this->table = newTable(capacity);
 
     this->hashCode = hashCode;
     this->loadFactor = loadFactor;
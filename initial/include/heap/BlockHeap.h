@@ -0,0 +1,400 @@
+#ifndef BLOCKHEAP_H
+#define BLOCKHEAP_H
+#include "heap/IHeap.h"
+#include "util/MemLib.h"
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+using namespace std;
+/*
+ * BlockHeap<T>: a binary heap in B-heap layout
+ *  + the array is cut into pages of P slots (P: power of two,
+ *      P * sizeof(T) <= blockBytes, 4096 by default: one memory page)
+ *  + a page holds a small complete subtree of P-1 nodes at offsets 1..P-1
+ *      (offset 0 is not used): the children of offset o are 2o and 2o+1
+ *  + the P/2 leaves of a page (o >= P/2) have their children at the roots
+ *      of P child pages: leaf l = o - P/2 of page g -> pages g*P+1+2l, g*P+2+2l
+ *  => one path root -> leaf touches about log2(n) / log2(P) pages
+ *     instead of about log2(n) - 10 pages for the classic layout (Heap<T>)
+ *
+ * The i-th item (0-based, the order of the classic array) is stored in
+ * page i / (P-1), at offset i % (P-1) + 1: pages are filled one by one.
+ *
+ * Same API and conventions as Heap<T>:
+ * function pointer: int (*comparator)(T& lhs, T& rhs)
+ *      return sign of (lhs - rhs); the item with the smallest value is at the root.
+ * function pointer: void (*deleteUserData)(BlockHeap<T>* pHeap)
+ *      Users should pass &BlockHeap<T>::free for "deleteUserData"
+ *      if T is a pointer type and the heap owns the pointed data.
+ */
+template <class T>
+class BlockHeap : public IHeap<T>
+{
+protected:
+    T *elements;                                 // pages * P slots
+    int capacity;                                // number of slots, a multiple of P
+    int count;                                   // current count of items stored in this heap
+    int pageSize;                                // P
+    int pageShift;                               // log2(P)
+    int (*comparator)(T &lhs, T &rhs);           // see above
+    void (*deleteUserData)(BlockHeap<T> *pHeap); // see above
+
+public:
+    BlockHeap(int (*comparator)(T &, T &) = 0,
+              void (*deleteUserData)(BlockHeap<T> *) = 0,
+              int blockBytes = 4096);
+    BlockHeap(const BlockHeap<T> &heap);
+    BlockHeap<T> &operator=(const BlockHeap<T> &heap);
+    ~BlockHeap();
+
+    // Inherit from IHeap: BEGIN
+    void push(T item);
+    T pop();
+    const T peek();
+    void remove(T item, void (*removeItemData)(T) = 0);
+    bool contains(T item);
+    int size();
+    void heapify(T array[], int size);
+    void clear();
+    bool empty();
+    string toString(string (*item2str)(T &) = 0);
+    // Inherit from IHeap: END
+
+    int getPageSize()
+    {
+        return pageSize;
+    }
+
+    void println(string (*item2str)(T &) = 0)
+    {
+        cout << toString(item2str) << endl;
+    }
+
+    static void free(BlockHeap<T> *pHeap)
+    {
+        for (int idx = 0; idx < pHeap->count; idx++)
+            delete pHeap->elements[pHeap->slotOf(idx)];
+    }
+
+private:
+    int compare(T &a, T &b)
+    {
+        if (comparator != 0)
+            return comparator(a, b);
+        else
+        {
+            if (a < b)
+                return -1;
+            else if (a > b)
+                return 1;
+            else
+                return 0;
+        }
+    }
+
+    /*
+     * slotOf(index): slot of the index-th item
+     *      increasing with index: the items are exactly the used slots < slotOf(count)
+     */
+    int slotOf(int index)
+    {
+        return (index / (pageSize - 1)) * pageSize + index % (pageSize - 1) + 1;
+    }
+    /*
+     * firstChild(slot): the second child is the next slot (same page)
+     *      or the root of the next page (slot + P)
+     *      long long: the child of the last leaf may be far beyond the array
+     */
+    long long firstChild(int slot)
+    {
+        long long page = slot >> pageShift;
+        int offset = slot & (pageSize - 1);
+        if (offset < pageSize / 2)
+            return slot + offset;
+        int leaf = offset - pageSize / 2;
+        return ((page << pageShift) + 1 + 2 * leaf) * pageSize + 1;
+    }
+    long long secondChild(int slot, long long first)
+    {
+        return (slot & (pageSize - 1)) < pageSize / 2 ? first + 1 : first + pageSize;
+    }
+    int parent(int slot)
+    {
+        int page = slot >> pageShift;
+        int offset = slot & (pageSize - 1);
+        if (offset > 1)
+            return (page << pageShift) + offset / 2;
+        int rank = page - 1; // rank among all child pages, P per parent page
+        return ((rank >> pageShift) << pageShift) + pageSize / 2 + (rank & (pageSize - 1)) / 2;
+    }
+
+    void ensureCapacity(int minCount);
+    void reheapUp(int slot);
+    void reheapDown(int slot);
+    int getItem(T &item);
+
+    void removeInternalData();
+    void copyFrom(const BlockHeap<T> &heap);
+};
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////     METHOD DEFNITION      ///////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T>
+BlockHeap<T>::BlockHeap(
+    int (*comparator)(T &, T &),
+    void (*deleteUserData)(BlockHeap<T> *),
+    int blockBytes)
+{
+    pageShift = 2; // at least 4 slots: 3 nodes per page
+    while ((2 << pageShift) * (int)sizeof(T) <= blockBytes)
+        pageShift++;
+    pageSize = 1 << pageShift;
+    capacity = pageSize;
+    count = 0;
+    elements = new T[capacity];
+    this->comparator = comparator;
+    this->deleteUserData = deleteUserData;
+}
+
+template <class T>
+BlockHeap<T>::BlockHeap(const BlockHeap<T> &heap)
+{
+    copyFrom(heap);
+}
+
+template <class T>
+BlockHeap<T> &BlockHeap<T>::operator=(const BlockHeap<T> &heap)
+{
+    if (this != &heap)
+    {
+        removeInternalData();
+        copyFrom(heap);
+    }
+    return *this;
+}
+
+template <class T>
+BlockHeap<T>::~BlockHeap()
+{
+    removeInternalData();
+}
+
+template <class T>
+void BlockHeap<T>::push(T item)
+{
+    ensureCapacity(count + 1);
+    int slot = slotOf(count);
+    elements[slot] = std::move(item);
+    count++;
+    reheapUp(slot);
+}
+
+template <class T>
+T BlockHeap<T>::pop()
+{
+    if (count == 0)
+        throw std::underflow_error("Calling to peek with the empty heap.");
+    T removed = std::move(elements[1]);
+    count--;
+    if (count > 0)
+    {
+        elements[1] = std::move(elements[slotOf(count)]);
+        reheapDown(1);
+    }
+    return removed;
+}
+
+template <class T>
+const T BlockHeap<T>::peek()
+{
+    if (count == 0)
+        throw std::underflow_error("Calling to peek with the empty heap.");
+    return elements[1];
+}
+
+template <class T>
+void BlockHeap<T>::remove(T item, void (*removeItemData)(T))
+{
+    int slot = getItem(item);
+    if (slot == -1)
+        return;
+    if (removeItemData)
+        removeItemData(elements[slot]);
+    count--;
+    int last = slotOf(count);
+    if (slot != last)
+    {
+        elements[slot] = std::move(elements[last]);
+        reheapUp(slot);
+        reheapDown(slot);
+    }
+}
+
+template <class T>
+bool BlockHeap<T>::contains(T item)
+{
+    return getItem(item) != -1;
+}
+
+template <class T>
+int BlockHeap<T>::size()
+{
+    return count;
+}
+
+/*
+ * heapify(array, size): Floyd's method, the internal nodes from the last one
+ */
+template <class T>
+void BlockHeap<T>::heapify(T array[], int size)
+{
+    clear();
+    ensureCapacity(size);
+    for (int i = 0; i < size; i++)
+        elements[slotOf(i)] = array[i];
+    count = size;
+    long long end = slotOf(count);
+    for (int i = size - 1; i >= 0; i--)
+    {
+        int slot = slotOf(i);
+        if (firstChild(slot) < end)
+            reheapDown(slot);
+    }
+}
+
+template <class T>
+void BlockHeap<T>::clear()
+{
+    removeInternalData();
+    capacity = pageSize;
+    count = 0;
+    elements = new T[capacity];
+}
+
+template <class T>
+bool BlockHeap<T>::empty()
+{
+    return count == 0;
+}
+
+/*
+ * toString(): the items in the order of the classic array layout
+ */
+template <class T>
+string BlockHeap<T>::toString(string (*item2str)(T &))
+{
+    stringstream os;
+    os << "[";
+    for (int idx = 0; idx < count; idx++)
+    {
+        if (item2str != 0)
+            os << item2str(elements[slotOf(idx)]);
+        else
+            os << elements[slotOf(idx)];
+        if (idx < count - 1)
+            os << ",";
+    }
+    os << "]";
+    return os.str();
+}
+
+//////////////////////////////////////////////////////////////////////
+//////////////////////// (private) METHOD DEFNITION //////////////////
+//////////////////////////////////////////////////////////////////////
+
+/*
+ * ensureCapacity(minCount): room for minCount items, growing by whole pages (x1.5)
+ */
+template <class T>
+void BlockHeap<T>::ensureCapacity(int minCount)
+{
+    int minPages = (minCount + pageSize - 2) / (pageSize - 1);
+    int pages = capacity >> pageShift;
+    if (minPages > pages)
+    {
+        pages = max(minPages, pages + (pages >> 1));
+        T *new_data = new T[(long long)pages * pageSize];
+        relocate(new_data, elements, capacity);
+        delete[] elements;
+        elements = new_data;
+        capacity = pages * pageSize;
+    }
+}
+
+template <class T>
+void BlockHeap<T>::reheapUp(int slot)
+{
+    T item = std::move(elements[slot]);
+    while (slot != 1)
+    {
+        int up = parent(slot);
+        if (compare(item, elements[up]) >= 0)
+            break;
+        elements[slot] = std::move(elements[up]);
+        slot = up;
+    }
+    elements[slot] = std::move(item);
+}
+
+/*
+ * reheapDown(slot): top-down: the climb back of Floyd's bottom-up variant
+ *      (Heap<T>) would visit the pages of the path a second time
+ */
+template <class T>
+void BlockHeap<T>::reheapDown(int slot)
+{
+    long long end = slotOf(count);
+    T item = std::move(elements[slot]);
+    while (true)
+    {
+        long long child = firstChild(slot);
+        if (child >= end)
+            break;
+        long long second = secondChild(slot, child);
+        if (second < end && compare(elements[second], elements[child]) < 0)
+            child = second;
+        if (compare(elements[child], item) >= 0)
+            break;
+        elements[slot] = std::move(elements[child]);
+        slot = (int)child;
+    }
+    elements[slot] = std::move(item);
+}
+
+template <class T>
+int BlockHeap<T>::getItem(T &item)
+{
+    for (int idx = 0; idx < count; idx++)
+    {
+        int slot = slotOf(idx);
+        if (compare(elements[slot], item) == 0)
+            return slot;
+    }
+    return -1;
+}
+
+template <class T>
+void BlockHeap<T>::removeInternalData()
+{
+    if (this->deleteUserData != 0)
+        deleteUserData(this);
+    delete[] elements;
+}
+
+template <class T>
+void BlockHeap<T>::copyFrom(const BlockHeap<T> &heap)
+{
+    capacity = heap.capacity;
+    count = heap.count;
+    pageSize = heap.pageSize;
+    pageShift = heap.pageShift;
+    elements = new T[capacity];
+    comparator = heap.comparator;
+    deleteUserData = nullptr;
+    for (int slot = 0; slot < capacity; slot++)
+        elements[slot] = heap.elements[slot];
+}
+
+#endif /* BLOCKHEAP_H */
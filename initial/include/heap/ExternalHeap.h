@@ -0,0 +1,414 @@
+#ifndef EXTERNALHEAP_H
+#define EXTERNALHEAP_H
+#include "heap/Heap.h"
+#include "heap/KWayMerger.h"
+#include <cstdio>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+using namespace std;
+/*
+ * ExternalHeap<T>: a priority queue larger than the memory
+ *  + an in-memory Heap<T> holds at most memoryItems items
+ *  + when it is full, its items are popped into a sorted run written to a
+ *      temporary file (tmpfile(): removed when closed), then the heap restarts empty
+ *  + the runs are merged back lazily by a KWayMerger<T>: reading one buffer
+ *      (bufferItems items) of a run at a time
+ *  + pop/peek: the better of the heap top and the merger top
+ *  + more than maxRuns runs: they are merged into one run (a compaction)
+ *      => memory: about memoryItems + maxRuns * bufferItems items
+ *
+ * T is written to the files byte by byte: it must be trivially copyable
+ * (int, double, struct of numbers, ...).
+ *
+ * function pointer: int (*comparator)(T& lhs, T& rhs)
+ *      same convention as Heap<T>: the item with the smallest value is popped first.
+ *
+ * Example:
+ *  ExternalHeap<long long> heap(0, 1 << 20); // 1M items in memory
+ *  for(...) heap.push(key);
+ *  while(!heap.empty()) process(heap.pop());
+ *  cout << heap.getStats().toString();
+ */
+template <class T>
+class ExternalHeap
+{
+    static_assert(is_trivially_copyable<T>::value,
+                  "ExternalHeap: T must be trivially copyable (it is written to files).");
+
+public:
+    // IOStats: BEGIN
+    class IOStats
+    {
+    public:
+        long long spills = 0;      // runs written from the in-memory heap
+        long long compactions = 0; // merges of all runs into one run
+        long long itemsWritten = 0;
+        long long itemsRead = 0;
+        long long writeCalls = 0; // fwrite
+        long long readCalls = 0;  // fread
+
+        long long bytesWritten()
+        {
+            return itemsWritten * (long long)sizeof(T);
+        }
+        long long bytesRead()
+        {
+            return itemsRead * (long long)sizeof(T);
+        }
+        string toString()
+        {
+            stringstream os;
+            os << "spills=" << spills << ", compactions=" << compactions
+               << ", written=" << bytesWritten() << "B/" << writeCalls << " calls"
+               << ", read=" << bytesRead() << "B/" << readCalls << " calls";
+            return os.str();
+        }
+    };
+    // IOStats: END
+
+    class FileRun; // forward declaration
+
+protected:
+    Heap<T> heap;                      // at most memoryItems items
+    KWayMerger<T> *merger;             // the runs on disk
+    int memoryItems;                   // see above
+    int bufferItems;                   // see above
+    int maxRuns;                       // see above
+    long long count;                   // items in the heap and in the runs
+    IOStats stats;                     // spill/merge I/O
+    int (*comparator)(T &lhs, T &rhs); // see above
+
+public:
+    ExternalHeap(int (*comparator)(T &, T &) = 0,
+                 int memoryItems = 1 << 20,
+                 int bufferItems = 1 << 12,
+                 int maxRuns = 64);
+    ~ExternalHeap();
+
+    void push(T item);
+    T pop();
+    const T peek();
+    long long size();
+    bool empty();
+    void clear();
+    int runCount();
+    IOStats &getStats();
+
+private:
+    ExternalHeap(const ExternalHeap<T> &heap);
+    ExternalHeap<T> &operator=(const ExternalHeap<T> &heap);
+
+    int compare(T &a, T &b)
+    {
+        if (comparator != 0)
+            return comparator(a, b);
+        else
+        {
+            if (a < b)
+                return -1;
+            else if (a > b)
+                return 1;
+            else
+                return 0;
+        }
+    }
+    bool topInMemory();
+    void spill();
+    void compact();
+    FILE *createFile();
+    void writeItems(FILE *file, T *items, int size);
+
+    //////////////////////////////////////////////////////////////////////
+    ////////////////////////  INNER CLASSES DEFNITION ////////////////////
+    //////////////////////////////////////////////////////////////////////
+public:
+    // FileRun: BEGIN
+    /*
+     * FileRun: a sorted run in a temporary file, read one buffer at a time;
+     *      the buffer and the file are released once the run is exhausted
+     */
+    class FileRun : public KWayMerger<T>::Run
+    {
+    private:
+        FILE *file;
+        long long remaining; // items not read yet from the file
+        T *buffer;
+        int bufferItems;
+        int cursor, filled;
+        IOStats *stats;
+
+    public:
+        FileRun(FILE *file, long long size, int bufferItems, IOStats *stats)
+        {
+            this->file = file;
+            this->remaining = size;
+            this->bufferItems = bufferItems;
+            this->buffer = new T[bufferItems];
+            this->cursor = this->filled = 0;
+            this->stats = stats;
+            rewind(file);
+            try
+            {
+                refill();
+            }
+            catch (...)
+            {
+                release(); // no destructor call for a constructor throwing
+                throw;
+            }
+        }
+        ~FileRun()
+        {
+            release();
+        }
+        bool hasItem() { return cursor < filled; }
+        T &current() { return buffer[cursor]; }
+        void advance()
+        {
+            cursor++;
+            if (cursor == filled)
+                refill();
+        }
+
+    private:
+        void refill()
+        {
+            cursor = filled = 0;
+            if (remaining == 0)
+            {
+                release();
+                return;
+            }
+            int wanted = (int)min(remaining, (long long)bufferItems);
+            filled = (int)fread(buffer, sizeof(T), wanted, file);
+            if (filled != wanted)
+                throw std::runtime_error("Cannot read a run from the temporary file.");
+            remaining -= filled;
+            stats->itemsRead += filled;
+            stats->readCalls++;
+        }
+        void release()
+        {
+            if (file != 0)
+                fclose(file);
+            file = 0;
+            delete[] buffer;
+            buffer = 0;
+        }
+    };
+    // FileRun: END
+};
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////     METHOD DEFNITION      ///////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T>
+ExternalHeap<T>::ExternalHeap(int (*comparator)(T &, T &), int memoryItems, int bufferItems, int maxRuns)
+    : heap(comparator)
+{
+    if (memoryItems <= 0 || bufferItems <= 0 || maxRuns < 2)
+        throw std::invalid_argument("Invalid memory limits.");
+    this->comparator = comparator;
+    this->memoryItems = memoryItems;
+    this->bufferItems = bufferItems;
+    this->maxRuns = maxRuns;
+    this->count = 0;
+    this->merger = new KWayMerger<T>(comparator);
+}
+
+template <class T>
+ExternalHeap<T>::~ExternalHeap()
+{
+    delete merger;
+}
+
+template <class T>
+void ExternalHeap<T>::push(T item)
+{
+    if (heap.size() >= memoryItems)
+        spill();
+    heap.push(item);
+    count++;
+}
+
+template <class T>
+T ExternalHeap<T>::pop()
+{
+    if (count == 0)
+        throw std::underflow_error("Calling to peek with the empty heap.");
+    count--;
+    if (topInMemory())
+        return heap.pop();
+    return merger->next();
+}
+
+template <class T>
+const T ExternalHeap<T>::peek()
+{
+    if (count == 0)
+        throw std::underflow_error("Calling to peek with the empty heap.");
+    if (topInMemory())
+        return heap.peek();
+    return merger->peek();
+}
+
+template <class T>
+long long ExternalHeap<T>::size()
+{
+    return count;
+}
+
+template <class T>
+bool ExternalHeap<T>::empty()
+{
+    return count == 0;
+}
+
+template <class T>
+void ExternalHeap<T>::clear()
+{
+    heap.clear();
+    delete merger;
+    merger = new KWayMerger<T>(comparator);
+    count = 0;
+}
+
+/*
+ * runCount(): runs added to the merger since the last compaction
+ *      (exhausted runs included)
+ */
+template <class T>
+int ExternalHeap<T>::runCount()
+{
+    return merger->runCount();
+}
+
+template <class T>
+typename ExternalHeap<T>::IOStats &ExternalHeap<T>::getStats()
+{
+    return stats;
+}
+
+//////////////////////////////////////////////////////////////////////
+//////////////////////// (private) METHOD DEFNITION //////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T>
+bool ExternalHeap<T>::topInMemory()
+{
+    if (!merger->hasNext())
+        return true;
+    if (heap.empty())
+        return false;
+    T inMemory = heap.peek();
+    T onDisk = merger->peek();
+    return compare(inMemory, onDisk) <= 0;
+}
+
+/*
+ * spill(): write the in-memory heap as a new sorted run, then empty it
+ *      a write error (disk full) leaves the heap as it was
+ */
+template <class T>
+void ExternalHeap<T>::spill()
+{
+    if (merger->runCount() >= maxRuns)
+        compact();
+    FILE *file = createFile();
+    int size = heap.size();
+    T *buffer = new T[bufferItems];
+    try
+    {
+        // items read in priority order without popping them
+        typename Heap<T>::SortedView view = heap.sortedView();
+        while (view.hasNext())
+        {
+            int filled = 0;
+            while (filled < bufferItems && view.hasNext())
+                buffer[filled++] = view.next();
+            writeItems(file, buffer, filled);
+        }
+    }
+    catch (...)
+    {
+        delete[] buffer;
+        fclose(file);
+        throw;
+    }
+    delete[] buffer;
+    FileRun *run = new FileRun(file, size, bufferItems, &stats);
+    heap.clear(); // the run is complete: the items may leave the memory
+    heap.reserve(size);
+    stats.spills++;
+    merger->addRun(run);
+}
+
+/*
+ * compact(): merge all runs into one run, in a new merger
+ *      on a write error no item is lost: the items already written stay
+ *      as a run of the old merger, those of the failed buffer go back to
+ *      the in-memory heap
+ */
+template <class T>
+void ExternalHeap<T>::compact()
+{
+    FILE *file = createFile();
+    long long size = 0;
+    T *buffer = new T[bufferItems];
+    int filled = 0;
+    try
+    {
+        while (merger->hasNext())
+        {
+            while (filled < bufferItems && merger->hasNext())
+                buffer[filled++] = merger->next();
+            writeItems(file, buffer, filled);
+            size += filled;
+            filled = 0;
+        }
+    }
+    catch (...)
+    {
+        for (int idx = 0; idx < filled; idx++)
+            heap.push(buffer[idx]);
+        delete[] buffer;
+        if (size > 0)
+            merger->addRun(new FileRun(file, size, bufferItems, &stats));
+        else
+            fclose(file);
+        throw;
+    }
+    delete[] buffer;
+    FileRun *run = new FileRun(file, size, bufferItems, &stats);
+    delete merger;
+    merger = new KWayMerger<T>(comparator);
+    stats.compactions++;
+    merger->addRun(run);
+}
+
+template <class T>
+FILE *ExternalHeap<T>::createFile()
+{
+    FILE *file = tmpfile();
+    if (file == 0)
+        throw std::runtime_error("Cannot create a temporary file.");
+    return file;
+}
+
+/*
+ * writeItems(file, items, size): the items are on disk when it returns
+ *      (flushed: a full disk is reported here, not when the run is read)
+ */
+template <class T>
+void ExternalHeap<T>::writeItems(FILE *file, T *items, int size)
+{
+    if ((int)fwrite(items, sizeof(T), size, file) != size || fflush(file) != 0)
+        throw std::runtime_error("Cannot write a run to the temporary file.");
+    stats.itemsWritten += size;
+    stats.writeCalls++;
+}
+
+#endif /* EXTERNALHEAP_H */
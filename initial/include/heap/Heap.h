@@ -3,6 +3,7 @@
 #include <memory.h>
 #include "heap/IHeap.h"
 #include "list/XArrayList.h"
+#include "util/MemLib.h"
 #include <sstream>
 #include <iostream>
 using namespace std;
@@ -18,12 +19,20 @@ using namespace std;
  *      remove user's data in case that T is a pointer type
  *      Users should pass &Heap<T>::free for "deleteUserData"
  *
+ * Storage:
+ *      grows geometrically (x1.5); items are moved, never deep-copied,
+ *      when the array is re-allocated (see relocate in util/MemLib.h).
+ *      push(T item) moves its argument into the heap,
+ *      so push(std::move(x)) and push(T(...)) do not copy the item.
+ *      Out of memory: std::bad_alloc reaches the caller, the heap is unchanged
+ *      (ExternalHeap<T> spills to disk instead).
  */
 template <class T>
 class Heap : public IHeap<T>
 {
 public:
-    class Iterator; // forward declaration
+    class Iterator;   // forward declaration
+    class SortedView; // forward declaration
 
 protected:
     T *elements;                            // a dynamic array to contain user's data
@@ -31,10 +40,12 @@ protected:
     int count;                              // current count of elements stored in this heap
     int (*comparator)(T &lhs, T &rhs);      // see above
     void (*deleteUserData)(Heap<T> *pHeap); // see above
+    pmr::memory_resource *resource;         // memory of the array (0: new[]/delete[]), see util/MemoryResource.h
 
 public:
     Heap(int (*comparator)(T &, T &) = 0,
-         void (*deleteUserData)(Heap<T> *) = 0);
+         void (*deleteUserData)(Heap<T> *) = 0,
+         pmr::memory_resource *resource = 0);
 
     Heap(const Heap<T> &heap);               // copy constructor
     Heap<T> &operator=(const Heap<T> &heap); // assignment operator
@@ -59,6 +70,33 @@ public:
         cout << toString(item2str) << endl;
     }
 
+    /*
+     * emplace(args...): construct the item from args, then push it
+     */
+    template <class... Args>
+    void emplace(Args &&...args)
+    {
+        ensureCapacity(count + 1);
+        elements[count] = T(std::forward<Args>(args)...);
+        reheapUp(count);
+        count++;
+    }
+    /*
+     * reserve(minCapacity): make room for minCapacity items at once
+     */
+    void reserve(int minCapacity)
+    {
+        ensureCapacity(minCapacity);
+    }
+    int getCapacity()
+    {
+        return capacity;
+    }
+
+    void pushAll(T array[], int size);
+    void pushAll(XArrayList<T> &arrayList);
+    T replaceTop(T item);
+
     Iterator begin()
     {
         return Iterator(this, true);
@@ -67,6 +105,11 @@ public:
     {
         return Iterator(this, false);
     }
+    SortedView sortedView()
+    {
+        return SortedView(this);
+    }
+    int drainTo(XArrayList<T> &arrayList);
 
 public:
     /* if T is pointer type:
@@ -82,7 +125,7 @@ public:
             delete pHeap->elements[idx];
     }
     void heapsortHuff(XArrayList<T> &arrayList);
-    void heapsort(XArrayList<T> &arrayList);
+    void heapsort(XArrayList<T> &arrayList, void (*traceStep)(XArrayList<T> &) = 0);
 
 private:
     bool aLTb(T &a, T &b)
@@ -108,6 +151,13 @@ private:
     void swap(int a, int b);
     void reheapUp(int position);
     void reheapDown(int position);
+    void reheapDownBottomUp(int position)
+    {
+        reheapDownBottomUp(elements, count, position);
+    }
+    void reheapDownBottomUp(T *array, int size, int position);
+    void sortDown(XArrayList<T> &arrayList, void (*traceStep)(XArrayList<T> &));
+    void rebuildFrom(int firstNew);
     int getItem(T item);
 
     void removeInternalData();
@@ -168,6 +218,118 @@ public:
         }
     };
     // Iterator: END
+
+    // SortedView: BEGIN
+    /*
+     * SortedView: the items in priority order (as pop() returns them),
+     *      without changing or copying the heap
+     *  + a small heap of positions (the "frontier") holds the candidates:
+     *      the root first, then the children of every position returned
+     *      => the first k items cost O(k log k), whatever the size of the heap
+     *  + the heap must not be changed while the view is used
+     * Example:
+     *  Heap<int>::SortedView view = heap.sortedView();
+     *  for (int i = 0; i < 10 && view.hasNext(); i++) cout << view.next();
+     */
+    class SortedView
+    {
+    private:
+        Heap<T> *heap;
+        int *frontier; // positions in heap->elements, the best item at frontier[0]
+        int capacity;
+        int count;
+
+    public:
+        SortedView(Heap<T> *heap)
+        {
+            this->heap = heap;
+            this->capacity = 16;
+            this->count = 0;
+            this->frontier = new int[capacity];
+            if (heap->count > 0)
+                frontier[count++] = 0;
+        }
+        SortedView(const SortedView &view)
+        {
+            copyFrom(view);
+        }
+        SortedView &operator=(const SortedView &view)
+        {
+            if (this != &view)
+            {
+                delete[] frontier;
+                copyFrom(view);
+            }
+            return *this;
+        }
+        ~SortedView()
+        {
+            delete[] frontier;
+        }
+
+        bool hasNext()
+        {
+            return count > 0;
+        }
+        T &next()
+        {
+            if (count == 0)
+                throw std::underflow_error("Calling to next with no item left.");
+            int position = frontier[0];
+            frontier[0] = frontier[--count];
+            reheapDown(0);
+            for (int child = position * 2 + 1; child <= position * 2 + 2; child++)
+                if (child < heap->count)
+                    push(child);
+            return heap->elements[position];
+        }
+
+    private:
+        bool before(int a, int b)
+        {
+            return heap->aLTb(heap->elements[a], heap->elements[b]);
+        }
+        void push(int position)
+        {
+            if (count == capacity)
+            {
+                int *newFrontier = new int[capacity * 2];
+                memcpy(newFrontier, frontier, count * sizeof(int));
+                delete[] frontier;
+                frontier = newFrontier;
+                capacity *= 2;
+            }
+            int idx = count++;
+            while (idx > 0 && before(position, frontier[(idx - 1) / 2]))
+            {
+                frontier[idx] = frontier[(idx - 1) / 2];
+                idx = (idx - 1) / 2;
+            }
+            frontier[idx] = position;
+        }
+        void reheapDown(int idx)
+        {
+            while (idx * 2 + 1 < count)
+            {
+                int child = idx * 2 + 1;
+                if (child + 1 < count && before(frontier[child + 1], frontier[child]))
+                    child++;
+                if (!before(frontier[child], frontier[idx]))
+                    break;
+                std::swap(frontier[child], frontier[idx]);
+                idx = child;
+            }
+        }
+        void copyFrom(const SortedView &view)
+        {
+            heap = view.heap;
+            capacity = view.capacity;
+            count = view.count;
+            frontier = new int[capacity];
+            memcpy(frontier, view.frontier, count * sizeof(int));
+        }
+    };
+    // SortedView: END
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -177,17 +339,20 @@ public:
 template <class T>
 Heap<T>::Heap(
     int (*comparator)(T &, T &),
-    void (*deleteUserData)(Heap<T> *))
+    void (*deleteUserData)(Heap<T> *),
+    pmr::memory_resource *resource)
 {
     capacity = 10;
     count = 0;
-    elements = new T[capacity];
+    this->resource = resource;
+    elements = newArray<T>(resource, capacity);
     this->comparator = comparator;
     this->deleteUserData = deleteUserData;
 }
 template <class T>
 Heap<T>::Heap(const Heap<T> &heap)
 {
+    resource = 0; // as std::pmr containers: a copy does not take the resource
     copyFrom(heap);
     // this->deleteUserData = heap.deleteUserData;
 }
@@ -211,10 +376,10 @@ Heap<T>::~Heap()
 
 template <class T>
 void Heap<T>::push(T item)
-{                              // item  = 25
-    ensureCapacity(count + 1); //[18, 15, 13, 25 , , ]
-    elements[count] = item;    // elements[3] = 25
-    reheapUp(count);           // reheapify
+{                                      // item  = 25
+    ensureCapacity(count + 1);         //[18, 15, 13, 25 , , ]
+    elements[count] = std::move(item); // elements[3] = 25
+    reheapUp(count);                   // reheapify
     count++;
 }
 /*
@@ -239,10 +404,27 @@ T Heap<T>::pop()
     if (count == 0)
         throw std::underflow_error("Calling to peek with the empty heap.");
 
-    T removed = elements[0];           // store the root
-    elements[0] = elements[count - 1]; // replace root with last element
+    T removed = std::move(elements[0]);           // store the root
+    elements[0] = std::move(elements[count - 1]); // replace root with last element
     count--;
-    reheapDown(0); // reheapify
+    reheapDownBottomUp(0); // reheapify
+    return removed;
+}
+
+/*
+ * replaceTop(item): same as pop() followed by push(item), with one reheapDown;
+ *      also used to re-position the root after its priority was changed in place,
+ *      e.g.: heap.replaceTop(heap.peek())
+ */
+template <class T>
+T Heap<T>::replaceTop(T item)
+{
+    if (count == 0)
+        throw std::underflow_error("Calling to peek with the empty heap.");
+
+    T removed = std::move(elements[0]);
+    elements[0] = std::move(item);
+    reheapDownBottomUp(0);
     return removed;
 }
 
@@ -276,7 +458,7 @@ void Heap<T>::remove(T item, void (*removeItemData)(T))
     // CASE 2: found at foundIdx
     if (removeItemData)
         removeItemData(elements[foundIdx]);
-    elements[foundIdx] = elements[count - 1];
+    elements[foundIdx] = std::move(elements[count - 1]);
     count--;
     reheapUp(foundIdx);
     reheapDown(foundIdx);
@@ -343,8 +525,40 @@ void Heap<T>::heapify(T array[], int size)
     this->count = size;
     for (int i = size / 2 - 1; i >= 0; i--)
     {
-        reheapDown(i);
+        reheapDownBottomUp(i);
+    }
+}
+
+/*
+ * pushAll(array, size): push a batch of items
+ *  + small batch: one reheapUp per item (O(1) expected per random item)
+ *  + large batch (at least twice the current size):
+ *      append all items, then reheapify only the subtrees containing new items,
+ *      O(size + log^2 n) whatever the order of the batch
+ */
+template <class T>
+void Heap<T>::pushAll(T array[], int size)
+{
+    if (size <= 0)
+        return;
+    ensureCapacity(count + size);
+    if (size < 2 * count)
+    {
+        for (int i = 0; i < size; i++)
+            push(array[i]);
+        return;
     }
+    int firstNew = count;
+    for (int i = 0; i < size; i++)
+        elements[count + i] = array[i];
+    count += size;
+    rebuildFrom(firstNew);
+}
+
+template <class T>
+void Heap<T>::pushAll(XArrayList<T> &arrayList)
+{
+    pushAll(arrayList.getData(), arrayList.size());
 }
 
 template <class T>
@@ -353,7 +567,7 @@ void Heap<T>::clear()
     removeInternalData();
     capacity = 10;
     count = 0;
-    elements = new T[capacity];
+    elements = newArray<T>(resource, capacity);
 }
 
 template <class T>
@@ -386,62 +600,52 @@ string Heap<T>::toString(string (*item2str)(T &))
     }
     return os.str();
 }
+/*
+ * heapsortHuff(arraylist): sort arraylist in place, the highest priority item LAST
+ *      (order used to build the Huffman tree)
+ */
 template <class T>
 void Heap<T>::heapsortHuff(XArrayList<T> &arraylist)
 {
-    count = arraylist.size();
-    ensureCapacity(count);
-
-    for (int i = 0; i < count; ++i)
-    {
-        elements[i] = arraylist.get(i);
-    }
-    for (int i = count / 2 - 1; i >= 0; --i)
-    {
-        reheapDown(i);
-    }
-
-    int originalCount = count;
-    for (int i = count - 1; i > 0; --i)
-    {
-        std::swap(elements[0], elements[i]);
-        count--;
-        reheapDown(0); 
-    }
-    count = originalCount;
+    sortDown(arraylist, 0);
+}
 
-    arraylist.clear();
-    for (int i = 0; i < count; ++i)
-    {
-        arraylist.add(elements[i]);
-    }
+/*
+ * heapsort(arraylist, traceStep): sort arraylist in place in priority order,
+ *      i.e., in the order pop() would return the items:
+ *      ascending with the default comparator, descending with a max comparator
+ *  + O(n log n), works on the backing array of arraylist:
+ *      no extra copy, no shifting, and this heap is not changed
+ *  + traceStep (debug hook, optional): called with arraylist after every step
+ */
+template <class T>
+void Heap<T>::heapsort(XArrayList<T> &arraylist, void (*traceStep)(XArrayList<T> &))
+{
+    sortDown(arraylist, traceStep);
+    T *data = arraylist.getData();
+    int size = arraylist.size();
+    for (int left = 0, right = size - 1; left < right; left++, right--)
+        std::swap(data[left], data[right]);
+    if (traceStep != 0 && size > 1)
+        traceStep(arraylist);
 }
+
+/*
+ * drainTo(arraylist): pop all items, in priority order, to the end of arraylist
+ *      items are moved (no copy); the heap is empty afterwards, its capacity is kept
+ *      and the ownership of pointed data goes to arraylist.
+ *      return the number of items moved
+ */
 template <class T>
-void Heap<T>::heapsort(XArrayList<T> &arraylist)
+int Heap<T>::drainTo(XArrayList<T> &arraylist)
 {
-    count = arraylist.size();
-    ensureCapacity(count);
-    for (int i = 0; i < count; ++i)
-    {
-        elements[i] = arraylist.get(i);
-    }
-    for (int i = count / 2 - 1; i >= 0; --i)
-    {
-        reheapDown(i);
-        
-    }
-    int originalCount = count;
-    for (int i = 0; i < originalCount; ++i)
-    {
-        T value = elements[0];
-        std::swap(elements[0], elements[count - 1]);
-        count--;
-        if (count > 0) reheapDown(0);
-        arraylist.removeAt(i);
-        arraylist.add(i, value);
-        arraylist.println();
-    }
+    int drained = count;
+    arraylist.reserve(arraylist.size() + count);
+    while (count > 0)
+        arraylist.add(pop());
+    return drained;
 }
+
 //////////////////////////////////////////////////////////////////////
 //////////////////////// (private) METHOD DEFNITION //////////////////
 //////////////////////////////////////////////////////////////////////
@@ -449,32 +653,22 @@ void Heap<T>::heapsort(XArrayList<T> &arraylist)
 template <class T>
 void Heap<T>::ensureCapacity(int minCapacity)
 {
-    if (minCapacity >= capacity)
+    if (minCapacity > capacity)
     {
-        // re-allocate
-        int old_capacity = capacity;
-        capacity = max(minCapacity, old_capacity + (old_capacity >> 2));
-        try
-        {
-            T *new_data = new T[capacity];
-            // OLD: memcpy(new_data, elements, capacity*sizeof(T));
-            memcpy(new_data, elements, old_capacity * sizeof(T));
-            delete[] elements;
-            elements = new_data;
-        }
-        catch (std::bad_alloc e)
-        {
-            e.what();
-        }
+        // re-allocate; std::bad_alloc is not caught: the heap is left unchanged
+        int new_capacity = max(minCapacity, capacity + (capacity >> 1));
+        T *new_data = newArray<T>(resource, new_capacity);
+        relocate(new_data, elements, count);
+        deleteArray(resource, elements, capacity);
+        elements = new_data;
+        capacity = new_capacity;
     }
 }
 
 template <class T>
 void Heap<T>::swap(int a, int b)
 {
-    T temp = this->elements[a];
-    this->elements[a] = this->elements[b];
-    this->elements[b] = temp;
+    std::swap(this->elements[a], this->elements[b]);
 }
 
 template <class T>
@@ -516,6 +710,83 @@ void Heap<T>::reheapDown(int position)
     }
 }
 
+/*
+ * reheapDownBottomUp(position): same result as reheapDown, fewer comparisons
+ *  (Floyd's bottom-up variant)
+ *  1. descend to a leaf along the smaller children: one comparison per level
+ *  2. climb back up to the first item smaller than the sifted item
+ *  3. put the sifted item there, shifting the items above it up one level
+ *  The sifted item usually belongs near the bottom (pop, heapify),
+ *  so step 2 is short and the comparisons are about halved.
+ */
+template <class T>
+void Heap<T>::reheapDownBottomUp(T *array, int size, int position)
+{
+    int lastPosition = size - 1;
+    int leaf = position;
+    int child = leaf * 2 + 1;
+    while (child <= lastPosition)
+    {
+        if (child + 1 <= lastPosition && !aLTb(array[child], array[child + 1]))
+            child++;
+        leaf = child;
+        child = leaf * 2 + 1;
+    }
+    while (leaf > position && !aLTb(array[leaf], array[position]))
+        leaf = (leaf - 1) / 2;
+
+    T item = std::move(array[position]);
+    while (leaf > position)
+    {
+        std::swap(item, array[leaf]);
+        leaf = (leaf - 1) / 2;
+    }
+    array[position] = std::move(item);
+}
+
+/*
+ * sortDown(arrayList, traceStep): in-place heapsort on the backing array of arrayList
+ *      1. heapify the array
+ *      2. repeatedly swap the root to the end of the shrinking heap
+ *      => the highest priority item ends up LAST
+ */
+template <class T>
+void Heap<T>::sortDown(XArrayList<T> &arrayList, void (*traceStep)(XArrayList<T> &))
+{
+    T *data = arrayList.getData();
+    int size = arrayList.size();
+    for (int i = size / 2 - 1; i >= 0; --i)
+        reheapDownBottomUp(data, size, i);
+    for (int last = size - 1; last > 0; --last)
+    {
+        std::swap(data[0], data[last]);
+        reheapDownBottomUp(data, last, 0);
+        if (traceStep != 0)
+            traceStep(arrayList);
+    }
+}
+
+/*
+ * rebuildFrom(firstNew): [0, firstNew) is a valid heap, [firstNew, count) are new items
+ *      => reheapify the ancestors of the new items only, level by level up to the root;
+ *         each pass skips the ancestors already handled by the previous pass
+ */
+template <class T>
+void Heap<T>::rebuildFrom(int firstNew)
+{
+    int high = (count - 2) / 2;                      // parent of the last item
+    int low = firstNew > 0 ? (firstNew - 1) / 2 : 0; // parent of the first new item
+    while (true)
+    {
+        for (int i = high; i >= low; i--)
+            reheapDownBottomUp(i);
+        if (low == 0)
+            break;
+        high = min((high - 1) / 2, low - 1);
+        low = (low - 1) / 2;
+    }
+}
+
 template <class T>
 int Heap<T>::getItem(T item)
 {
@@ -536,7 +807,7 @@ void Heap<T>::removeInternalData()
 {
     if (this->deleteUserData != 0)
         deleteUserData(this); // clear users's data if they want
-    delete[] elements;
+    deleteArray(resource, elements, capacity);
 }
 
 template <class T>
@@ -544,7 +815,7 @@ void Heap<T>::copyFrom(const Heap<T> &heap)
 {
     capacity = heap.capacity;
     count = heap.count;
-    elements = new T[capacity];
+    elements = newArray<T>(resource, capacity);
     this->comparator = heap.comparator;
     this->deleteUserData = nullptr;
 
@@ -0,0 +1,382 @@
+#ifndef INDEXEDHEAP_H
+#define INDEXEDHEAP_H
+#include <memory.h>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+using namespace std;
+/*
+ * IndexedHeap<T>: an addressable binary heap
+ *  + every item is pushed together with an integer key in [0, MAX_KEY),
+ *      e.g.: the vertex id in a shortest-path search.
+ *      Keys index three arrays sized by the largest key pushed: use dense
+ *      ids (0, 1, 2, ...); push throws length_error for key >= MAX_KEY.
+ *      The key is the stable handle of the item while it stays in the heap.
+ *  + pos[key] is kept up-to-date inside every swap, so:
+ *      contains(key)           : O(1)
+ *      get(key)                : O(1)
+ *      update(key, newItem)    : O(log n) (decrease-key and increase-key)
+ *      erase(key)              : O(log n)
+ *
+ * function pointer: int (*comparator)(T& lhs, T& rhs)
+ *      same convention as Heap<T>: return sign of (lhs - rhs);
+ *      the item with the smallest value is at the root.
+ */
+template <class T>
+class IndexedHeap
+{
+public:
+    static const int MAX_KEY = 1 << 28; // see above
+
+protected:
+    int *heap;                         // heap[position] = key stored at position
+    int *pos;                          // pos[key] = position of key in heap, -1 if key is not in heap
+    T *items;                          // items[key] = item pushed with key
+    int capacity;                      // number of keys that can be addressed without re-allocation
+    int count;                         // current count of items stored in this heap
+    int (*comparator)(T &lhs, T &rhs); // see above
+
+public:
+    IndexedHeap(int (*comparator)(T &, T &) = 0, int capacity = 10);
+    IndexedHeap(const IndexedHeap<T> &heap);
+    IndexedHeap<T> &operator=(const IndexedHeap<T> &heap);
+    ~IndexedHeap();
+
+    void push(int key, T item);
+    T pop();
+    int popKey();
+    const T peek();
+    int peekKey();
+    T &get(int key);
+    void update(int key, T item);
+    void erase(int key);
+    bool contains(int key);
+    int size();
+    bool empty();
+    void clear();
+    string toString(string (*item2str)(T &) = 0);
+
+    void println(string (*item2str)(T &) = 0)
+    {
+        cout << toString(item2str) << endl;
+    }
+
+private:
+    bool aLTb(int keyA, int keyB)
+    {
+        return compare(items[keyA], items[keyB]) < 0;
+    }
+    int compare(T &a, T &b)
+    {
+        if (comparator != 0)
+            return comparator(a, b);
+        else
+        {
+            if (a < b)
+                return -1;
+            else if (a > b)
+                return 1;
+            else
+                return 0;
+        }
+    }
+
+    void ensureKeyCapacity(int key);
+    void swap(int a, int b);
+    void reheapUp(int position);
+    void reheapDown(int position);
+    void checkKey(int key);
+    void removeAt(int position);
+
+    void removeInternalData();
+    void copyFrom(const IndexedHeap<T> &heap);
+};
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////     METHOD DEFNITION      ///////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T>
+IndexedHeap<T>::IndexedHeap(int (*comparator)(T &, T &), int capacity)
+{
+    this->capacity = capacity > 0 ? capacity : 10;
+    this->count = 0;
+    this->comparator = comparator;
+    this->heap = new int[this->capacity];
+    this->pos = new int[this->capacity];
+    this->items = new T[this->capacity];
+    for (int key = 0; key < this->capacity; key++)
+        pos[key] = -1;
+}
+
+template <class T>
+IndexedHeap<T>::IndexedHeap(const IndexedHeap<T> &heap)
+{
+    copyFrom(heap);
+}
+
+template <class T>
+IndexedHeap<T> &IndexedHeap<T>::operator=(const IndexedHeap<T> &heap)
+{
+    if (this != &heap)
+    {
+        removeInternalData();
+        copyFrom(heap);
+    }
+    return *this;
+}
+
+template <class T>
+IndexedHeap<T>::~IndexedHeap()
+{
+    removeInternalData();
+}
+
+template <class T>
+void IndexedHeap<T>::push(int key, T item)
+{
+    if (key < 0)
+        throw std::out_of_range("Key is out of range!");
+    ensureKeyCapacity(key);
+    if (pos[key] != -1)
+        throw std::invalid_argument("Key is already in the heap.");
+
+    items[key] = item;
+    heap[count] = key;
+    pos[key] = count;
+    count++;
+    reheapUp(count - 1);
+}
+
+template <class T>
+T IndexedHeap<T>::pop()
+{
+    if (count == 0)
+        throw std::underflow_error("Calling to peek with the empty heap.");
+    int key = heap[0];
+    T removed = items[key];
+    removeAt(0);
+    return removed;
+}
+
+template <class T>
+int IndexedHeap<T>::popKey()
+{
+    if (count == 0)
+        throw std::underflow_error("Calling to peek with the empty heap.");
+    int key = heap[0];
+    removeAt(0);
+    return key;
+}
+
+template <class T>
+const T IndexedHeap<T>::peek()
+{
+    if (count == 0)
+        throw std::underflow_error("Calling to peek with the empty heap.");
+    return items[heap[0]];
+}
+
+template <class T>
+int IndexedHeap<T>::peekKey()
+{
+    if (count == 0)
+        throw std::underflow_error("Calling to peek with the empty heap.");
+    return heap[0];
+}
+
+template <class T>
+T &IndexedHeap<T>::get(int key)
+{
+    checkKey(key);
+    return items[key];
+}
+
+/*
+ * update(key, item): replace the item of key, then restore the heap
+ *      from its position: only one of reheapUp/reheapDown moves it.
+ */
+template <class T>
+void IndexedHeap<T>::update(int key, T item)
+{
+    checkKey(key);
+    items[key] = item;
+    reheapUp(pos[key]);
+    reheapDown(pos[key]);
+}
+
+template <class T>
+void IndexedHeap<T>::erase(int key)
+{
+    checkKey(key);
+    removeAt(pos[key]);
+}
+
+template <class T>
+bool IndexedHeap<T>::contains(int key)
+{
+    return key >= 0 && key < capacity && pos[key] != -1;
+}
+
+template <class T>
+int IndexedHeap<T>::size()
+{
+    return count;
+}
+
+template <class T>
+bool IndexedHeap<T>::empty()
+{
+    return count == 0;
+}
+
+template <class T>
+void IndexedHeap<T>::clear()
+{
+    for (int idx = 0; idx < count; idx++)
+        pos[heap[idx]] = -1;
+    count = 0;
+}
+
+template <class T>
+string IndexedHeap<T>::toString(string (*item2str)(T &))
+{
+    stringstream os;
+    os << "[";
+    for (int idx = 0; idx < count; idx++)
+    {
+        int key = heap[idx];
+        os << "(" << key << ",";
+        if (item2str != 0)
+            os << item2str(items[key]);
+        else
+            os << items[key];
+        os << ")";
+        if (idx < count - 1)
+            os << ",";
+    }
+    os << "]";
+    return os.str();
+}
+
+//////////////////////////////////////////////////////////////////////
+//////////////////////// (private) METHOD DEFNITION //////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T>
+void IndexedHeap<T>::ensureKeyCapacity(int key)
+{
+    if (key < capacity)
+        return;
+    if (key >= MAX_KEY)
+        throw std::length_error("Key is too large for an IndexedHeap.");
+    int old_capacity = capacity;
+    int new_capacity = (int)min((long long)MAX_KEY, max(key + 1LL, old_capacity * 2LL));
+
+    int *new_heap = new int[new_capacity];
+    int *new_pos = new int[new_capacity];
+    T *new_items = new T[new_capacity];
+    memcpy(new_heap, heap, count * sizeof(int));
+    memcpy(new_pos, pos, old_capacity * sizeof(int));
+    for (int idx = old_capacity; idx < new_capacity; idx++)
+        new_pos[idx] = -1;
+    for (int idx = 0; idx < count; idx++)
+        new_items[heap[idx]] = items[heap[idx]];
+
+    delete[] heap;
+    delete[] pos;
+    delete[] items;
+    heap = new_heap;
+    pos = new_pos;
+    items = new_items;
+    capacity = new_capacity;
+}
+
+template <class T>
+void IndexedHeap<T>::swap(int a, int b)
+{
+    int temp = heap[a];
+    heap[a] = heap[b];
+    heap[b] = temp;
+    pos[heap[a]] = a;
+    pos[heap[b]] = b;
+}
+
+template <class T>
+void IndexedHeap<T>::reheapUp(int position)
+{
+    while (position > 0)
+    {
+        int parent = (position - 1) / 2;
+        if (!aLTb(heap[position], heap[parent]))
+            break;
+        swap(position, parent);
+        position = parent;
+    }
+}
+
+template <class T>
+void IndexedHeap<T>::reheapDown(int position)
+{
+    int lastPosition = count - 1;
+    while (true)
+    {
+        int leftChild = position * 2 + 1;
+        int rightChild = position * 2 + 2;
+        if (leftChild > lastPosition)
+            break;
+        int smallChild = leftChild;
+        if (rightChild <= lastPosition && !aLTb(heap[leftChild], heap[rightChild]))
+            smallChild = rightChild;
+        if (!aLTb(heap[smallChild], heap[position]))
+            break;
+        swap(smallChild, position);
+        position = smallChild;
+    }
+}
+
+template <class T>
+void IndexedHeap<T>::checkKey(int key)
+{
+    if (!contains(key))
+        throw std::out_of_range("Key is not in the heap.");
+}
+
+template <class T>
+void IndexedHeap<T>::removeAt(int position)
+{
+    int key = heap[position];
+    swap(position, count - 1);
+    count--;
+    pos[key] = -1;
+    if (position < count)
+    {
+        reheapUp(position);
+        reheapDown(position);
+    }
+}
+
+template <class T>
+void IndexedHeap<T>::removeInternalData()
+{
+    delete[] heap;
+    delete[] pos;
+    delete[] items;
+}
+
+template <class T>
+void IndexedHeap<T>::copyFrom(const IndexedHeap<T> &heap)
+{
+    capacity = heap.capacity;
+    count = heap.count;
+    comparator = heap.comparator;
+    this->heap = new int[capacity];
+    this->pos = new int[capacity];
+    this->items = new T[capacity];
+    memcpy(this->heap, heap.heap, count * sizeof(int));
+    memcpy(this->pos, heap.pos, capacity * sizeof(int));
+    for (int idx = 0; idx < count; idx++)
+        this->items[heap.heap[idx]] = heap.items[heap.heap[idx]];
+}
+
+#endif /* INDEXEDHEAP_H */
@@ -0,0 +1,227 @@
+#ifndef KWAYMERGER_H
+#define KWAYMERGER_H
+#include "heap/Heap.h"
+#include "list/XArrayList.h"
+#include "list/DLinkedList.h"
+#include <stdexcept>
+using namespace std;
+/*
+ * KWayMerger<T>: merge k sorted runs into one sorted stream, lazily
+ *  + runs: raw arrays, XArrayList, DLinkedList, or any subclass of Run
+ *  + a Heap<Run*> orders the runs by their current item:
+ *      next() costs O(log k), merging N items in total costs O(N log k)
+ *  + items equal by the comparator come out in the order the runs were added
+ *  + the inputs are read in place: they must not change during the merge
+ *
+ * function pointer: int (*comparator)(T& lhs, T& rhs)
+ *      same convention as Heap<T>; every run must be sorted by this comparator
+ *
+ * Example:
+ *  KWayMerger<int> merger;
+ *  merger.addRun(list1);
+ *  merger.addRun(array, size);
+ *  while(merger.hasNext()) cout << merger.next();
+ */
+template <class T>
+class KWayMerger
+{
+public:
+    class Run; // forward declaration
+
+protected:
+    Heap<Run *> heap;                  // runs having items, the run with the smallest current item at the root
+    XArrayList<Run *> runs;            // all runs, deleted with the merger
+    int (*comparator)(T &lhs, T &rhs); // see above
+
+public:
+    KWayMerger(int (*comparator)(T &, T &) = 0);
+    ~KWayMerger();
+
+    void addRun(T array[], int size);
+    void addRun(XArrayList<T> &list);
+    void addRun(DLinkedList<T> &list);
+    void addRun(Run *run);
+
+    bool hasNext();
+    const T peek();
+    T next();
+    void mergeTo(XArrayList<T> &output);
+    int runCount();
+
+private:
+    KWayMerger(const KWayMerger<T> &merger);
+    KWayMerger<T> &operator=(const KWayMerger<T> &merger);
+
+    static int compareItems(int (*comparator)(T &, T &), T &a, T &b)
+    {
+        if (comparator != 0)
+            return comparator(a, b);
+        else
+        {
+            if (a < b)
+                return -1;
+            else if (a > b)
+                return 1;
+            else
+                return 0;
+        }
+    }
+    static int compareRuns(Run *&lhs, Run *&rhs)
+    {
+        int sign = compareItems(lhs->comparator, lhs->current(), rhs->current());
+        if (sign != 0)
+            return sign;
+        return lhs->order - rhs->order;
+    }
+
+    //////////////////////////////////////////////////////////////////////
+    ////////////////////////  INNER CLASSES DEFNITION ////////////////////
+    //////////////////////////////////////////////////////////////////////
+public:
+    // Run: BEGIN
+    /*
+     * Run: a cursor over a sorted sequence
+     *      subclasses implement hasItem, current and advance
+     */
+    class Run
+    {
+    private:
+        int (*comparator)(T &, T &);
+        int order;
+        friend class KWayMerger<T>;
+
+    public:
+        virtual ~Run() {}
+        virtual bool hasItem() = 0;
+        virtual T &current() = 0;
+        virtual void advance() = 0;
+    };
+
+    class ArrayRun : public Run
+    {
+    private:
+        T *cursor;
+        T *last;
+
+    public:
+        ArrayRun(T *array, int size)
+        {
+            this->cursor = array;
+            this->last = array + size;
+        }
+        bool hasItem() { return cursor != last; }
+        T &current() { return *cursor; }
+        void advance() { cursor++; }
+    };
+
+    class ListRun : public Run
+    {
+    private:
+        typename DLinkedList<T>::Iterator cursor;
+        typename DLinkedList<T>::Iterator last;
+
+    public:
+        ListRun(DLinkedList<T> &list)
+        {
+            this->cursor = list.begin();
+            this->last = list.end();
+        }
+        bool hasItem() { return cursor != last; }
+        T &current() { return *cursor; }
+        void advance() { ++cursor; }
+    };
+    // Run: END
+};
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////     METHOD DEFNITION      ///////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T>
+KWayMerger<T>::KWayMerger(int (*comparator)(T &, T &))
+    : heap(&KWayMerger<T>::compareRuns)
+{
+    this->comparator = comparator;
+}
+
+template <class T>
+KWayMerger<T>::~KWayMerger()
+{
+    for (int i = 0; i < runs.size(); i++)
+        delete runs.get(i);
+}
+
+template <class T>
+void KWayMerger<T>::addRun(T array[], int size)
+{
+    addRun(new ArrayRun(array, size));
+}
+
+template <class T>
+void KWayMerger<T>::addRun(XArrayList<T> &list)
+{
+    addRun(new ArrayRun(list.getData(), list.size()));
+}
+
+template <class T>
+void KWayMerger<T>::addRun(DLinkedList<T> &list)
+{
+    addRun(new ListRun(list));
+}
+
+/*
+ * addRun(run): the merger takes the ownership of run (deleted with the merger)
+ */
+template <class T>
+void KWayMerger<T>::addRun(Run *run)
+{
+    run->comparator = comparator;
+    run->order = runs.size();
+    runs.add(run);
+    if (run->hasItem())
+        heap.push(run);
+}
+
+template <class T>
+bool KWayMerger<T>::hasNext()
+{
+    return !heap.empty();
+}
+
+template <class T>
+const T KWayMerger<T>::peek()
+{
+    if (heap.empty())
+        throw std::underflow_error("Calling to peek with no item left.");
+    return heap.peek()->current();
+}
+
+template <class T>
+T KWayMerger<T>::next()
+{
+    if (heap.empty())
+        throw std::underflow_error("Calling to next with no item left.");
+    Run *run = heap.peek();
+    T item = run->current();
+    run->advance();
+    if (run->hasItem())
+        heap.replaceTop(run); // same run, new current item
+    else
+        heap.pop();
+    return item;
+}
+
+template <class T>
+void KWayMerger<T>::mergeTo(XArrayList<T> &output)
+{
+    while (!heap.empty())
+        output.add(next());
+}
+
+template <class T>
+int KWayMerger<T>::runCount()
+{
+    return runs.size();
+}
+
+#endif /* KWAYMERGER_H */
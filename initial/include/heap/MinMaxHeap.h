@@ -0,0 +1,426 @@
+#ifndef MINMAXHEAP_H
+#define MINMAXHEAP_H
+#include "heap/IHeap.h"
+#include "util/MemLib.h"
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+using namespace std;
+/*
+ * MinMaxHeap<T>: a double-ended priority queue on a single array
+ *  + levels alternate: even levels (root: level 0) are min levels,
+ *      odd levels are max levels
+ *      => the smallest item is at the root,
+ *         the largest item is one of the root's children
+ *  + peekMin, peekMax: O(1); push, popMin, popMax: O(log n)
+ *  + pop/peek (IHeap) work on the min end
+ *
+ * function pointer: int (*comparator)(T& lhs, T& rhs)
+ *      same convention as Heap<T>: return sign of (lhs - rhs);
+ *      "min" and "max" are defined by this comparator.
+ *
+ * function pointer: void (*deleteUserData)(MinMaxHeap<T>* pHeap)
+ *      Users should pass &MinMaxHeap<T>::free for "deleteUserData"
+ *      if T is a pointer type and the heap owns the pointed data.
+ */
+template <class T>
+class MinMaxHeap : public IHeap<T>
+{
+protected:
+    T *elements;                                  // a dynamic array to contain user's data
+    int capacity;                                 // size of the dynamic array
+    int count;                                    // current count of elements stored in this heap
+    int (*comparator)(T &lhs, T &rhs);            // see above
+    void (*deleteUserData)(MinMaxHeap<T> *pHeap); // see above
+
+public:
+    MinMaxHeap(int (*comparator)(T &, T &) = 0,
+               void (*deleteUserData)(MinMaxHeap<T> *) = 0);
+    MinMaxHeap(const MinMaxHeap<T> &heap);
+    MinMaxHeap<T> &operator=(const MinMaxHeap<T> &heap);
+    ~MinMaxHeap();
+
+    // Inherit from IHeap: BEGIN
+    void push(T item);
+    T pop();
+    const T peek();
+    void remove(T item, void (*removeItemData)(T) = 0);
+    bool contains(T item);
+    int size();
+    void heapify(T array[], int size);
+    void clear();
+    bool empty();
+    string toString(string (*item2str)(T &) = 0);
+    // Inherit from IHeap: END
+
+    T popMin();
+    T popMax();
+    const T peekMin();
+    const T peekMax();
+
+    void println(string (*item2str)(T &) = 0)
+    {
+        cout << toString(item2str) << endl;
+    }
+
+    static void free(MinMaxHeap<T> *pHeap)
+    {
+        for (int idx = 0; idx < pHeap->count; idx++)
+            delete pHeap->elements[idx];
+    }
+
+private:
+    int compare(T &a, T &b)
+    {
+        if (comparator != 0)
+            return comparator(a, b);
+        else
+        {
+            if (a < b)
+                return -1;
+            else if (a > b)
+                return 1;
+            else
+                return 0;
+        }
+    }
+    /*
+     * before(a, b, onMinLevel): a must be nearer to the root than b
+     *      min level: a < b; max level: a > b
+     */
+    bool before(T &a, T &b, bool onMinLevel)
+    {
+        int sign = compare(a, b);
+        return onMinLevel ? sign < 0 : sign > 0;
+    }
+    static bool isMinLevel(int position)
+    {
+        int level = 0;
+        for (int node = position + 1; node > 1; node >>= 1)
+            level++;
+        return (level & 1) == 0;
+    }
+
+    void ensureCapacity(int minCapacity);
+    void swap(int a, int b)
+    {
+        std::swap(elements[a], elements[b]);
+    }
+    void reheapUp(int position);
+    void reheapUpLevel(int position, bool onMinLevel);
+    void reheapDown(int position);
+    int maxPosition();
+    T removeAt(int position);
+    int getItem(T item);
+
+    void removeInternalData();
+    void copyFrom(const MinMaxHeap<T> &heap);
+};
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////     METHOD DEFNITION      ///////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T>
+MinMaxHeap<T>::MinMaxHeap(
+    int (*comparator)(T &, T &),
+    void (*deleteUserData)(MinMaxHeap<T> *))
+{
+    capacity = 10;
+    count = 0;
+    elements = new T[capacity];
+    this->comparator = comparator;
+    this->deleteUserData = deleteUserData;
+}
+
+template <class T>
+MinMaxHeap<T>::MinMaxHeap(const MinMaxHeap<T> &heap)
+{
+    copyFrom(heap);
+}
+
+template <class T>
+MinMaxHeap<T> &MinMaxHeap<T>::operator=(const MinMaxHeap<T> &heap)
+{
+    if (this != &heap)
+    {
+        removeInternalData();
+        copyFrom(heap);
+    }
+    return *this;
+}
+
+template <class T>
+MinMaxHeap<T>::~MinMaxHeap()
+{
+    removeInternalData();
+}
+
+template <class T>
+void MinMaxHeap<T>::push(T item)
+{
+    ensureCapacity(count + 1);
+    elements[count] = std::move(item);
+    count++;
+    reheapUp(count - 1);
+}
+
+template <class T>
+T MinMaxHeap<T>::pop()
+{
+    return popMin();
+}
+
+template <class T>
+const T MinMaxHeap<T>::peek()
+{
+    return peekMin();
+}
+
+template <class T>
+T MinMaxHeap<T>::popMin()
+{
+    if (count == 0)
+        throw std::underflow_error("Calling to peek with the empty heap.");
+    return removeAt(0);
+}
+
+template <class T>
+T MinMaxHeap<T>::popMax()
+{
+    if (count == 0)
+        throw std::underflow_error("Calling to peek with the empty heap.");
+    return removeAt(maxPosition());
+}
+
+template <class T>
+const T MinMaxHeap<T>::peekMin()
+{
+    if (count == 0)
+        throw std::underflow_error("Calling to peek with the empty heap.");
+    return elements[0];
+}
+
+template <class T>
+const T MinMaxHeap<T>::peekMax()
+{
+    if (count == 0)
+        throw std::underflow_error("Calling to peek with the empty heap.");
+    return elements[maxPosition()];
+}
+
+/*
+ * remove(item): linear search (as Heap<T>::remove),
+ *      then the array is re-heapified in O(n)
+ */
+template <class T>
+void MinMaxHeap<T>::remove(T item, void (*removeItemData)(T))
+{
+    int foundIdx = getItem(item);
+    if (foundIdx == -1)
+        return;
+    if (removeItemData)
+        removeItemData(elements[foundIdx]);
+    elements[foundIdx] = std::move(elements[count - 1]);
+    count--;
+    for (int i = count / 2 - 1; i >= 0; i--)
+        reheapDown(i);
+}
+
+template <class T>
+bool MinMaxHeap<T>::contains(T item)
+{
+    return getItem(item) != -1;
+}
+
+template <class T>
+int MinMaxHeap<T>::size()
+{
+    return count;
+}
+
+template <class T>
+void MinMaxHeap<T>::heapify(T array[], int size)
+{
+    clear();
+    ensureCapacity(size);
+    for (int i = 0; i < size; i++)
+        elements[i] = array[i];
+    count = size;
+    for (int i = size / 2 - 1; i >= 0; i--)
+        reheapDown(i);
+}
+
+template <class T>
+void MinMaxHeap<T>::clear()
+{
+    removeInternalData();
+    capacity = 10;
+    count = 0;
+    elements = new T[capacity];
+}
+
+template <class T>
+bool MinMaxHeap<T>::empty()
+{
+    return count == 0;
+}
+
+template <class T>
+string MinMaxHeap<T>::toString(string (*item2str)(T &))
+{
+    stringstream os;
+    os << "[";
+    for (int idx = 0; idx < count; idx++)
+    {
+        if (item2str != 0)
+            os << item2str(elements[idx]);
+        else
+            os << elements[idx];
+        if (idx < count - 1)
+            os << ",";
+    }
+    os << "]";
+    return os.str();
+}
+
+//////////////////////////////////////////////////////////////////////
+//////////////////////// (private) METHOD DEFNITION //////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T>
+void MinMaxHeap<T>::ensureCapacity(int minCapacity)
+{
+    if (minCapacity > capacity)
+    {
+        int old_capacity = capacity;
+        capacity = max(minCapacity, old_capacity + (old_capacity >> 1));
+        T *new_data = new T[capacity];
+        relocate(new_data, elements, count);
+        delete[] elements;
+        elements = new_data;
+    }
+}
+
+/*
+ * reheapUp(position): compare with the parent (a level of the other kind) first,
+ *      then move up through the grandparents (levels of the same kind)
+ */
+template <class T>
+void MinMaxHeap<T>::reheapUp(int position)
+{
+    if (position <= 0)
+        return;
+    int parent = (position - 1) / 2;
+    bool onMinLevel = isMinLevel(position);
+    if (before(elements[parent], elements[position], onMinLevel))
+    {
+        // the item belongs to the parent's kind of level
+        swap(position, parent);
+        reheapUpLevel(parent, !onMinLevel);
+    }
+    else
+        reheapUpLevel(position, onMinLevel);
+}
+
+template <class T>
+void MinMaxHeap<T>::reheapUpLevel(int position, bool onMinLevel)
+{
+    while (position >= 3)
+    {
+        int grandparent = (position - 3) / 4;
+        if (!before(elements[position], elements[grandparent], onMinLevel))
+            break;
+        swap(position, grandparent);
+        position = grandparent;
+    }
+}
+
+/*
+ * reheapDown(position): move the item down to the best of its children and
+ *      grandchildren (smallest on a min level, largest on a max level)
+ */
+template <class T>
+void MinMaxHeap<T>::reheapDown(int position)
+{
+    bool onMinLevel = isMinLevel(position);
+    while (true)
+    {
+        int firstChild = position * 2 + 1;
+        if (firstChild >= count)
+            break;
+
+        int best = firstChild;
+        int candidates[] = {firstChild + 1,
+                            firstChild * 2 + 1, firstChild * 2 + 2,
+                            firstChild * 2 + 3, firstChild * 2 + 4};
+        for (int candidate : candidates)
+            if (candidate < count && before(elements[candidate], elements[best], onMinLevel))
+                best = candidate;
+
+        if (!before(elements[best], elements[position], onMinLevel))
+            break;
+        swap(best, position);
+        if (best <= firstChild + 1)
+            break; // a child: its subtree is not touched
+
+        int parent = (best - 1) / 2;
+        if (before(elements[parent], elements[best], onMinLevel))
+            swap(best, parent);
+        position = best;
+    }
+}
+
+template <class T>
+int MinMaxHeap<T>::maxPosition()
+{
+    if (count == 1)
+        return 0;
+    if (count == 2)
+        return 1;
+    return compare(elements[1], elements[2]) >= 0 ? 1 : 2;
+}
+
+template <class T>
+T MinMaxHeap<T>::removeAt(int position)
+{
+    T removed = std::move(elements[position]);
+    count--;
+    if (position < count)
+    {
+        elements[position] = std::move(elements[count]);
+        reheapDown(position);
+    }
+    return removed;
+}
+
+template <class T>
+int MinMaxHeap<T>::getItem(T item)
+{
+    for (int idx = 0; idx < count; idx++)
+        if (compare(elements[idx], item) == 0)
+            return idx;
+    return -1;
+}
+
+template <class T>
+void MinMaxHeap<T>::removeInternalData()
+{
+    if (this->deleteUserData != 0)
+        deleteUserData(this);
+    delete[] elements;
+}
+
+template <class T>
+void MinMaxHeap<T>::copyFrom(const MinMaxHeap<T> &heap)
+{
+    capacity = heap.capacity;
+    count = heap.count;
+    elements = new T[capacity];
+    comparator = heap.comparator;
+    deleteUserData = nullptr;
+    for (int idx = 0; idx < count; idx++)
+        elements[idx] = heap.elements[idx];
+}
+
+#endif /* MINMAXHEAP_H */
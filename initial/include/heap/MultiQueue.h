@@ -0,0 +1,319 @@
+#ifndef MULTIQUEUE_H
+#define MULTIQUEUE_H
+#include "heap/Heap.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <stdexcept>
+using namespace std;
+/*
+ * MultiQueue<T>: a relaxed concurrent priority queue
+ *  + c*P internal Heap<T> (P: number of threads, c: shards per thread),
+ *      each guarded by its own mutex, taken with try_lock only
+ *  + push: into a random heap
+ *  + tryPop: look at two random heaps, pop from the one with the better top
+ *  => no global lock; the order is relaxed: an item popped is among the best
+ *     O(c*P) items on average, not always the best one
+ *
+ * function pointer: int (*comparator)(T& lhs, T& rhs)
+ *      same convention as Heap<T>
+ *
+ * Quality metrics:
+ *  + lockFailures(): failed try_lock calls (contention)
+ *  + rank error: number of better items still queued when an item is popped
+ *      (0 for an exact priority queue); sampleRankError(every) measures it on
+ *      one pop out of "every" (0: off, the default) by locking the other heaps
+ *      one at a time => an estimate, other threads keep pushing and popping;
+ *      meanRankError(), maxRankError(), rankSamples()
+ */
+template <class T>
+class MultiQueue
+{
+protected:
+    struct alignas(64) Shard
+    {
+        Heap<T> *heap;
+        mutex lock;
+    };
+    Shard *shards;                     // c*P heaps
+    int nShards;                       // number of heaps
+    atomic<long long> count;           // number of items stored in all heaps
+    atomic<long long> failures;        // number of failed try_lock
+    int sampleEvery;                   // rank error of one pop out of sampleEvery (0: off)
+    atomic<long long> pops;            // pops since sampling started
+    atomic<long long> samples;         // pops whose rank error was measured
+    atomic<long long> rankErrorSum;
+    atomic<long long> rankErrorMax;
+    int (*comparator)(T &lhs, T &rhs); // see above
+
+public:
+    MultiQueue(int nThreads, int (*comparator)(T &, T &) = 0, int shardsPerThread = 2);
+    ~MultiQueue();
+
+    void push(T item);
+    bool tryPop(T &item);
+    long long size();
+    bool empty();
+    int shardCount();
+    long long lockFailures();
+    void sampleRankError(int every);
+    double meanRankError();
+    long long maxRankError();
+    long long rankSamples();
+
+private:
+    MultiQueue(const MultiQueue<T> &queue);
+    MultiQueue<T> &operator=(const MultiQueue<T> &queue);
+
+    int compare(T &a, T &b)
+    {
+        if (comparator != 0)
+            return comparator(a, b);
+        else
+        {
+            if (a < b)
+                return -1;
+            else if (a > b)
+                return 1;
+            else
+                return 0;
+        }
+    }
+    /*
+     * randomShard(): xorshift per thread, no shared state
+     */
+    int randomShard()
+    {
+        static thread_local unsigned int seed =
+            (unsigned int)hash<thread::id>()(this_thread::get_id()) | 1u;
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return (int)(seed % (unsigned int)nShards);
+    }
+    bool popExhaustive(T &item);
+    void popped(T &item, Heap<T> *from);
+};
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////     METHOD DEFNITION      ///////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T>
+MultiQueue<T>::MultiQueue(int nThreads, int (*comparator)(T &, T &), int shardsPerThread)
+    : count(0), failures(0), pops(0), samples(0), rankErrorSum(0), rankErrorMax(0)
+{
+    if (nThreads <= 0 || shardsPerThread <= 0)
+        throw std::invalid_argument("Number of threads and shards must be positive.");
+    this->comparator = comparator;
+    this->sampleEvery = 0;
+    this->nShards = max(2, nThreads * shardsPerThread);
+    this->shards = new Shard[nShards];
+    for (int idx = 0; idx < nShards; idx++)
+        shards[idx].heap = new Heap<T>(comparator);
+}
+
+template <class T>
+MultiQueue<T>::~MultiQueue()
+{
+    for (int idx = 0; idx < nShards; idx++)
+        delete shards[idx].heap;
+    delete[] shards;
+}
+
+template <class T>
+void MultiQueue<T>::push(T item)
+{
+    while (true)
+    {
+        Shard &shard = shards[randomShard()];
+        if (shard.lock.try_lock())
+        {
+            shard.heap->push(std::move(item));
+            // counted before unlocking: a pop of this item never sees count at 0
+            count.fetch_add(1, memory_order_relaxed);
+            shard.lock.unlock();
+            return;
+        }
+        failures.fetch_add(1, memory_order_relaxed);
+    }
+}
+
+/*
+ * tryPop(item): return false if the queue is empty
+ *      a busy heap is never waited for: another pair is drawn instead
+ */
+template <class T>
+bool MultiQueue<T>::tryPop(T &item)
+{
+    int misses = 0; // both heaps seen empty
+    while (misses < nShards && count.load(memory_order_relaxed) > 0)
+    {
+        int first = randomShard();
+        int second = randomShard();
+        if (first == second)
+            second = (second + 1) % nShards;
+        Shard &shard1 = shards[first];
+        Shard &shard2 = shards[second];
+        if (!shard1.lock.try_lock())
+        {
+            failures.fetch_add(1, memory_order_relaxed);
+            continue;
+        }
+        if (!shard2.lock.try_lock())
+        {
+            shard1.lock.unlock();
+            failures.fetch_add(1, memory_order_relaxed);
+            continue;
+        }
+
+        Heap<T> *best = 0;
+        if (!shard1.heap->empty())
+            best = shard1.heap;
+        if (!shard2.heap->empty())
+        {
+            if (best == 0)
+                best = shard2.heap;
+            else
+            {
+                T top1 = shard1.heap->peek();
+                T top2 = shard2.heap->peek();
+                if (compare(top2, top1) < 0)
+                    best = shard2.heap;
+            }
+        }
+        if (best != 0)
+        {
+            item = best->pop();
+            count.fetch_sub(1, memory_order_relaxed);
+        }
+        else
+            misses++;
+        shard2.lock.unlock();
+        shard1.lock.unlock();
+        if (best != 0)
+        {
+            popped(item, best);
+            return true;
+        }
+    }
+    return popExhaustive(item);
+}
+
+template <class T>
+long long MultiQueue<T>::size()
+{
+    return count.load(memory_order_relaxed);
+}
+
+template <class T>
+bool MultiQueue<T>::empty()
+{
+    return size() == 0;
+}
+
+template <class T>
+int MultiQueue<T>::shardCount()
+{
+    return nShards;
+}
+
+template <class T>
+long long MultiQueue<T>::lockFailures()
+{
+    return failures.load(memory_order_relaxed);
+}
+
+/*
+ * sampleRankError(every): measure the rank error of one pop out of every
+ *      (0: off); call it before the threads start, it resets the statistics
+ */
+template <class T>
+void MultiQueue<T>::sampleRankError(int every)
+{
+    if (every < 0)
+        throw std::invalid_argument("Sampling period must be non-negative.");
+    sampleEvery = every;
+    pops.store(0);
+    samples.store(0);
+    rankErrorSum.store(0);
+    rankErrorMax.store(0);
+}
+
+template <class T>
+double MultiQueue<T>::meanRankError()
+{
+    long long n = samples.load(memory_order_relaxed);
+    return n > 0 ? (double)rankErrorSum.load(memory_order_relaxed) / n : 0;
+}
+
+template <class T>
+long long MultiQueue<T>::maxRankError()
+{
+    return rankErrorMax.load(memory_order_relaxed);
+}
+
+template <class T>
+long long MultiQueue<T>::rankSamples()
+{
+    return samples.load(memory_order_relaxed);
+}
+
+//////////////////////////////////////////////////////////////////////
+//////////////////////// (private) METHOD DEFNITION //////////////////
+//////////////////////////////////////////////////////////////////////
+
+/*
+ * popExhaustive(item): the random pairs kept finding empty heaps:
+ *      visit every heap (blocking lock) before reporting an empty queue
+ */
+template <class T>
+bool MultiQueue<T>::popExhaustive(T &item)
+{
+    int start = randomShard();
+    for (int step = 0; step < nShards; step++)
+    {
+        Shard &shard = shards[(start + step) % nShards];
+        shard.lock.lock();
+        if (!shard.heap->empty())
+        {
+            item = shard.heap->pop();
+            count.fetch_sub(1, memory_order_relaxed);
+            shard.lock.unlock();
+            popped(item, shard.heap);
+            return true;
+        }
+        shard.lock.unlock();
+    }
+    return false;
+}
+
+/*
+ * popped(item, from): item has just been popped from the heap "from" (no lock held);
+ *      one pop out of sampleEvery: count the queued items better than item,
+ *      locking one heap at a time (items read in order, down to item)
+ */
+template <class T>
+void MultiQueue<T>::popped(T &item, Heap<T> *from)
+{
+    if (sampleEvery == 0 || pops.fetch_add(1, memory_order_relaxed) % sampleEvery != 0)
+        return;
+    long long better = 0;
+    for (int idx = 0; idx < nShards; idx++)
+    {
+        if (shards[idx].heap == from)
+            continue; // its top was item: nothing better at the time of the pop
+        lock_guard<mutex> guard(shards[idx].lock);
+        typename Heap<T>::SortedView view = shards[idx].heap->sortedView();
+        while (view.hasNext() && compare(view.next(), item) < 0)
+            better++;
+    }
+    samples.fetch_add(1, memory_order_relaxed);
+    rankErrorSum.fetch_add(better, memory_order_relaxed);
+    long long worst = rankErrorMax.load(memory_order_relaxed);
+    while (better > worst && !rankErrorMax.compare_exchange_weak(worst, better, memory_order_relaxed))
+        ;
+}
+
+#endif /* MULTIQUEUE_H */
@@ -0,0 +1,507 @@
+#ifndef PAIRINGHEAP_H
+#define PAIRINGHEAP_H
+#include "heap/IHeap.h"
+#include "list/XArrayList.h"
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+using namespace std;
+/*
+ * PairingHeap<T>: a heap-ordered multiway tree
+ *  + push, peek, meld: O(1)
+ *  + pop: two-pass pairing of the root's children, amortized O(log n)
+ *  + meld(other): link the two roots, then splice the node pool of other
+ *      into this heap; other becomes empty. No item is copied or pushed again.
+ *
+ * Node pool:
+ *      nodes are allocated by blocks (16, 32, ... up to 1024 nodes),
+ *      freed nodes go to a free list; both the block chain and the
+ *      free list are spliced in O(1) by meld.
+ *
+ * function pointer: int (*comparator)(T& lhs, T& rhs)
+ *      same convention as Heap<T>: return sign of (lhs - rhs);
+ *      the item with the smallest value is at the root.
+ *      meld uses the comparator of this heap.
+ *
+ * function pointer: void (*deleteUserData)(PairingHeap<T>* pHeap)
+ *      Users should pass &PairingHeap<T>::free for "deleteUserData"
+ *      if T is a pointer type and the heap owns the pointed data.
+ */
+template <class T>
+class PairingHeap : public IHeap<T>
+{
+protected:
+    class Node;  // forward declaration
+    class Block; // forward declaration
+
+    Node *root;                                    // the item with the highest priority
+    int count;                                     // current count of items stored in this heap
+    Block *blockHead, *blockTail;                  // chain of node blocks owned by this heap
+    Node *freeHead, *freeTail;                     // free nodes, linked by sibling
+    int nextBlockSize;                             // size of the next block allocated
+    int (*comparator)(T &lhs, T &rhs);             // see above
+    void (*deleteUserData)(PairingHeap<T> *pHeap); // see above
+
+public:
+    PairingHeap(int (*comparator)(T &, T &) = 0,
+                void (*deleteUserData)(PairingHeap<T> *) = 0);
+    PairingHeap(const PairingHeap<T> &heap);
+    PairingHeap<T> &operator=(const PairingHeap<T> &heap);
+    ~PairingHeap();
+
+    // Inherit from IHeap: BEGIN
+    void push(T item);
+    T pop();
+    const T peek();
+    void remove(T item, void (*removeItemData)(T) = 0);
+    bool contains(T item);
+    int size();
+    void heapify(T array[], int size);
+    void clear();
+    bool empty();
+    string toString(string (*item2str)(T &) = 0);
+    // Inherit from IHeap: END
+
+    void meld(PairingHeap<T> &other);
+
+    void println(string (*item2str)(T &) = 0)
+    {
+        cout << toString(item2str) << endl;
+    }
+
+    static void free(PairingHeap<T> *pHeap)
+    {
+        XArrayList<Node *> nodes;
+        pHeap->collect(nodes);
+        for (int idx = 0; idx < nodes.size(); idx++)
+            delete nodes.get(idx)->item;
+    }
+
+private:
+    int compare(T &a, T &b)
+    {
+        if (comparator != 0)
+            return comparator(a, b);
+        else
+        {
+            if (a < b)
+                return -1;
+            else if (a > b)
+                return 1;
+            else
+                return 0;
+        }
+    }
+
+    Node *allocNode();
+    void freeNode(Node *node);
+    Node *link(Node *a, Node *b);
+    Node *mergePairs(Node *first);
+    void cut(Node *node);
+    Node *findNode(T &item);
+    void collect(XArrayList<Node *> &nodes);
+
+    void removeInternalData();
+    void copyFrom(const PairingHeap<T> &heap);
+
+    //////////////////////////////////////////////////////////////////////
+    ////////////////////////  INNER CLASSES DEFNITION ////////////////////
+    //////////////////////////////////////////////////////////////////////
+protected:
+    class Node
+    {
+    public:
+        T item;
+        Node *child;   // leftmost child
+        Node *sibling; // right sibling (next free node in the free list)
+        Node *prev;    // left sibling, or parent for the leftmost child
+    };
+
+    class Block
+    {
+    public:
+        Node *nodes;
+        Block *next;
+
+        Block(int size)
+        {
+            this->nodes = new Node[size];
+            this->next = 0;
+        }
+        ~Block()
+        {
+            delete[] nodes;
+        }
+    };
+};
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////     METHOD DEFNITION      ///////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T>
+PairingHeap<T>::PairingHeap(
+    int (*comparator)(T &, T &),
+    void (*deleteUserData)(PairingHeap<T> *))
+{
+    this->root = 0;
+    this->count = 0;
+    this->blockHead = this->blockTail = 0;
+    this->freeHead = this->freeTail = 0;
+    this->nextBlockSize = 16;
+    this->comparator = comparator;
+    this->deleteUserData = deleteUserData;
+}
+
+template <class T>
+PairingHeap<T>::PairingHeap(const PairingHeap<T> &heap)
+{
+    copyFrom(heap);
+}
+
+template <class T>
+PairingHeap<T> &PairingHeap<T>::operator=(const PairingHeap<T> &heap)
+{
+    if (this != &heap)
+    {
+        removeInternalData();
+        copyFrom(heap);
+    }
+    return *this;
+}
+
+template <class T>
+PairingHeap<T>::~PairingHeap()
+{
+    removeInternalData();
+}
+
+template <class T>
+void PairingHeap<T>::push(T item)
+{
+    Node *node = allocNode();
+    node->item = std::move(item);
+    root = link(root, node);
+    count++;
+}
+
+template <class T>
+T PairingHeap<T>::pop()
+{
+    if (count == 0)
+        throw std::underflow_error("Calling to peek with the empty heap.");
+    Node *top = root;
+    T removed = std::move(top->item);
+    root = mergePairs(top->child);
+    if (root != 0)
+        root->prev = 0;
+    freeNode(top);
+    count--;
+    return removed;
+}
+
+template <class T>
+const T PairingHeap<T>::peek()
+{
+    if (count == 0)
+        throw std::underflow_error("Calling to peek with the empty heap.");
+    return root->item;
+}
+
+/*
+ * remove(item): linear search (as Heap<T>::remove),
+ *      then the node's subtree is cut, its children paired and linked to the root
+ */
+template <class T>
+void PairingHeap<T>::remove(T item, void (*removeItemData)(T))
+{
+    Node *node = findNode(item);
+    if (node == 0)
+        return;
+    if (removeItemData)
+        removeItemData(node->item);
+    if (node == root)
+    {
+        pop();
+        return;
+    }
+    cut(node);
+    Node *subtree = mergePairs(node->child);
+    if (subtree != 0)
+        subtree->prev = 0;
+    root = link(root, subtree);
+    freeNode(node);
+    count--;
+}
+
+template <class T>
+bool PairingHeap<T>::contains(T item)
+{
+    return findNode(item) != 0;
+}
+
+template <class T>
+int PairingHeap<T>::size()
+{
+    return count;
+}
+
+template <class T>
+void PairingHeap<T>::heapify(T array[], int size)
+{
+    clear();
+    for (int i = 0; i < size; i++)
+        push(array[i]);
+}
+
+template <class T>
+void PairingHeap<T>::clear()
+{
+    removeInternalData();
+    root = 0;
+    count = 0;
+    blockHead = blockTail = 0;
+    freeHead = freeTail = 0;
+    nextBlockSize = 16;
+}
+
+template <class T>
+bool PairingHeap<T>::empty()
+{
+    return count == 0;
+}
+
+/*
+ * toString(): the items in pre-order (root, then the subtrees of its children)
+ */
+template <class T>
+string PairingHeap<T>::toString(string (*item2str)(T &))
+{
+    XArrayList<Node *> nodes;
+    collect(nodes);
+    stringstream os;
+    os << "[";
+    for (int idx = 0; idx < nodes.size(); idx++)
+    {
+        if (item2str != 0)
+            os << item2str(nodes.get(idx)->item);
+        else
+            os << nodes.get(idx)->item;
+        if (idx < nodes.size() - 1)
+            os << ",";
+    }
+    os << "]";
+    return os.str();
+}
+
+/*
+ * meld(other): move all items of other into this heap in O(1)
+ */
+template <class T>
+void PairingHeap<T>::meld(PairingHeap<T> &other)
+{
+    if (this == &other)
+        return;
+    root = link(root, other.root);
+    count += other.count;
+
+    // splice the block chain
+    if (other.blockHead != 0)
+    {
+        if (blockTail != 0)
+            blockTail->next = other.blockHead;
+        else
+            blockHead = other.blockHead;
+        blockTail = other.blockTail;
+    }
+    // splice the free list
+    if (other.freeHead != 0)
+    {
+        if (freeTail != 0)
+            freeTail->sibling = other.freeHead;
+        else
+            freeHead = other.freeHead;
+        freeTail = other.freeTail;
+    }
+    nextBlockSize = max(nextBlockSize, other.nextBlockSize);
+
+    other.root = 0;
+    other.count = 0;
+    other.blockHead = other.blockTail = 0;
+    other.freeHead = other.freeTail = 0;
+    other.nextBlockSize = 16;
+}
+
+//////////////////////////////////////////////////////////////////////
+//////////////////////// (private) METHOD DEFNITION //////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T>
+typename PairingHeap<T>::Node *PairingHeap<T>::allocNode()
+{
+    if (freeHead == 0)
+    {
+        Block *block = new Block(nextBlockSize);
+        if (blockTail != 0)
+            blockTail->next = block;
+        else
+            blockHead = block;
+        blockTail = block;
+        for (int idx = 0; idx < nextBlockSize - 1; idx++)
+            block->nodes[idx].sibling = &block->nodes[idx + 1];
+        block->nodes[nextBlockSize - 1].sibling = 0;
+        freeHead = &block->nodes[0];
+        freeTail = &block->nodes[nextBlockSize - 1];
+        nextBlockSize = min(nextBlockSize * 2, 1024);
+    }
+    Node *node = freeHead;
+    freeHead = node->sibling;
+    if (freeHead == 0)
+        freeTail = 0;
+    node->child = node->sibling = node->prev = 0;
+    return node;
+}
+
+template <class T>
+void PairingHeap<T>::freeNode(Node *node)
+{
+    node->sibling = freeHead;
+    freeHead = node;
+    if (freeTail == 0)
+        freeTail = node;
+}
+
+/*
+ * link(a, b): a, b are roots (no sibling); the one with the lower priority
+ *      becomes the leftmost child of the other
+ */
+template <class T>
+typename PairingHeap<T>::Node *PairingHeap<T>::link(Node *a, Node *b)
+{
+    if (a == 0)
+        return b;
+    if (b == 0)
+        return a;
+    if (compare(b->item, a->item) < 0)
+        std::swap(a, b);
+    b->prev = a;
+    b->sibling = a->child;
+    if (a->child != 0)
+        a->child->prev = b;
+    a->child = b;
+    return a;
+}
+
+/*
+ * mergePairs(first): two-pass pairing of the sibling list starting at first
+ *      pass 1 (left to right): link pairs, chaining the results in reverse
+ *      pass 2: link the results one by one (right to left)
+ */
+template <class T>
+typename PairingHeap<T>::Node *PairingHeap<T>::mergePairs(Node *first)
+{
+    Node *pairs = 0;
+    while (first != 0)
+    {
+        Node *a = first;
+        Node *b = a->sibling;
+        first = b != 0 ? b->sibling : 0;
+        a->sibling = a->prev = 0;
+        if (b != 0)
+            b->sibling = b->prev = 0;
+        Node *linked = link(a, b);
+        linked->sibling = pairs;
+        pairs = linked;
+    }
+    Node *result = 0;
+    while (pairs != 0)
+    {
+        Node *next = pairs->sibling;
+        pairs->sibling = 0;
+        result = link(result, pairs);
+        pairs = next;
+    }
+    return result;
+}
+
+/*
+ * cut(node): detach the subtree of node (not the root) from its parent
+ */
+template <class T>
+void PairingHeap<T>::cut(Node *node)
+{
+    if (node->prev->child == node)
+        node->prev->child = node->sibling; // leftmost child: prev is the parent
+    else
+        node->prev->sibling = node->sibling;
+    if (node->sibling != 0)
+        node->sibling->prev = node->prev;
+    node->sibling = node->prev = 0;
+}
+
+template <class T>
+typename PairingHeap<T>::Node *PairingHeap<T>::findNode(T &item)
+{
+    XArrayList<Node *> nodes;
+    collect(nodes);
+    for (int idx = 0; idx < nodes.size(); idx++)
+        if (compare(nodes.get(idx)->item, item) == 0)
+            return nodes.get(idx);
+    return 0;
+}
+
+/*
+ * collect(nodes): all nodes in pre-order, with an explicit stack
+ *      (a pairing heap can be very deep)
+ */
+template <class T>
+void PairingHeap<T>::collect(XArrayList<Node *> &nodes)
+{
+    if (root == 0)
+        return;
+    XArrayList<Node *> stack;
+    stack.add(root);
+    while (!stack.empty())
+    {
+        Node *node = stack.removeAt(stack.size() - 1);
+        nodes.add(node);
+        if (node->sibling != 0)
+            stack.add(node->sibling);
+        if (node->child != 0)
+            stack.add(node->child);
+    }
+}
+
+template <class T>
+void PairingHeap<T>::removeInternalData()
+{
+    if (this->deleteUserData != 0)
+        deleteUserData(this);
+    while (blockHead != 0)
+    {
+        Block *next = blockHead->next;
+        delete blockHead;
+        blockHead = next;
+    }
+}
+
+/*
+ * copyFrom(heap): the items are pushed again, O(1) each
+ */
+template <class T>
+void PairingHeap<T>::copyFrom(const PairingHeap<T> &heap)
+{
+    root = 0;
+    count = 0;
+    blockHead = blockTail = 0;
+    freeHead = freeTail = 0;
+    nextBlockSize = 16;
+    comparator = heap.comparator;
+    deleteUserData = nullptr;
+    XArrayList<Node *> nodes;
+    const_cast<PairingHeap<T> &>(heap).collect(nodes);
+    for (int idx = 0; idx < nodes.size(); idx++)
+        push(nodes.get(idx)->item);
+}
+
+#endif /* PAIRINGHEAP_H */
@@ -0,0 +1,286 @@
+#ifndef RADIXHEAP_H
+#define RADIXHEAP_H
+#include "list/XArrayList.h"
+#include <limits>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+using namespace std;
+/*
+ * RadixHeap<Key, Value>: a monotone priority queue for unsigned integer keys
+ *  + monotone: a pushed key must not be smaller than the last popped key,
+ *      e.g.: timestamps, distances in a shortest-path search
+ *  + no comparator: the smallest key is at the top
+ *  + bucket i (i >= 1) holds the keys whose highest bit differing from
+ *      the last popped key is bit i-1; bucket 0 holds keys equal to it
+ *  + pop on an empty bucket 0: the first non-empty bucket is split into
+ *      the lower buckets; every item moves down at most log C times
+ *      => push O(1), pop amortized O(log C), C: the largest key
+ *  + the buckets are XArrayList: sequential in memory, kept between pops
+ *  + peek/peekKey move nothing (the bound stays the last popped key): the
+ *      smallest key of the first non-empty bucket is found by a scan, kept
+ *      until a push of a smaller key or a pop
+ *
+ * Example:
+ *  RadixHeap<unsigned long long, int> heap;
+ *  heap.push(dist, vertex);
+ *  unsigned long long dist = heap.peekKey();
+ *  int vertex = heap.pop();
+ */
+template <class Key, class Value>
+class RadixHeap
+{
+    static_assert(is_integral<Key>::value && is_unsigned<Key>::value,
+                  "RadixHeap: Key must be an unsigned integer type.");
+
+public:
+    class Entry; // forward declaration
+
+protected:
+    static const int N_BUCKETS = numeric_limits<Key>::digits + 1;
+    XArrayList<Entry> *buckets; // N_BUCKETS buckets
+    Key last;                   // last popped key (0 at the beginning)
+    int count;                  // current count of items stored in this heap
+    int topBucket, topIndex;    // smallest item found by peek (topBucket -1: none)
+
+public:
+    RadixHeap();
+    ~RadixHeap();
+
+    void push(Key key, Value value);
+    Value pop();
+    Key popKey();
+    const Value peek();
+    Key peekKey();
+    int size();
+    bool empty();
+    void clear();
+    string toString(string (*value2str)(Value &) = 0);
+
+    void println(string (*value2str)(Value &) = 0)
+    {
+        cout << toString(value2str) << endl;
+    }
+
+private:
+    RadixHeap(const RadixHeap<Key, Value> &heap);
+    RadixHeap<Key, Value> &operator=(const RadixHeap<Key, Value> &heap);
+
+    /*
+     * bucketOf(key): 0 if key == last, else 1 + index of the highest differing bit
+     */
+    int bucketOf(Key key)
+    {
+        unsigned long long diff = (unsigned long long)(key ^ last);
+        if (diff == 0)
+            return 0;
+#if defined(__GNUC__)
+        return 64 - __builtin_clzll(diff);
+#else
+        int width = 0;
+        for (; diff != 0; diff >>= 1)
+            width++;
+        return width;
+#endif
+    }
+    void refill();
+    Entry &top();
+
+    //////////////////////////////////////////////////////////////////////
+    ////////////////////////  INNER CLASSES DEFNITION ////////////////////
+    //////////////////////////////////////////////////////////////////////
+public:
+    class Entry
+    {
+    public:
+        Key key;
+        Value value;
+
+        bool operator==(const Entry &other) const
+        {
+            return key == other.key && value == other.value;
+        }
+        friend ostream &operator<<(ostream &os, const Entry &entry)
+        {
+            os << "(" << entry.key << "," << entry.value << ")";
+            return os;
+        }
+    };
+};
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////     METHOD DEFNITION      ///////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class Key, class Value>
+RadixHeap<Key, Value>::RadixHeap()
+{
+    this->buckets = new XArrayList<Entry>[N_BUCKETS];
+    this->last = 0;
+    this->count = 0;
+    this->topBucket = -1;
+}
+
+template <class Key, class Value>
+RadixHeap<Key, Value>::~RadixHeap()
+{
+    delete[] buckets;
+}
+
+template <class Key, class Value>
+void RadixHeap<Key, Value>::push(Key key, Value value)
+{
+    if (key < last)
+        throw std::invalid_argument("Key is smaller than the last popped key.");
+    int b = bucketOf(key);
+    if (topBucket != -1 && (b < topBucket || key < buckets[topBucket].get(topIndex).key))
+        topBucket = -1; // new smallest item
+    buckets[b].add(Entry{key, std::move(value)});
+    count++;
+}
+
+template <class Key, class Value>
+Value RadixHeap<Key, Value>::pop()
+{
+    if (count == 0)
+        throw std::underflow_error("Calling to peek with the empty heap.");
+    refill();
+    count--;
+    return buckets[0].removeAt(buckets[0].size() - 1).value; // all keys of bucket 0 are equal
+}
+
+template <class Key, class Value>
+Key RadixHeap<Key, Value>::popKey()
+{
+    if (count == 0)
+        throw std::underflow_error("Calling to peek with the empty heap.");
+    refill();
+    count--;
+    buckets[0].removeAt(buckets[0].size() - 1);
+    return last;
+}
+
+template <class Key, class Value>
+const Value RadixHeap<Key, Value>::peek()
+{
+    if (count == 0)
+        throw std::underflow_error("Calling to peek with the empty heap.");
+    return top().value;
+}
+
+template <class Key, class Value>
+Key RadixHeap<Key, Value>::peekKey()
+{
+    if (count == 0)
+        throw std::underflow_error("Calling to peek with the empty heap.");
+    return top().key;
+}
+
+template <class Key, class Value>
+int RadixHeap<Key, Value>::size()
+{
+    return count;
+}
+
+template <class Key, class Value>
+bool RadixHeap<Key, Value>::empty()
+{
+    return count == 0;
+}
+
+/*
+ * clear(): also resets the monotone bound: any key can be pushed again
+ */
+template <class Key, class Value>
+void RadixHeap<Key, Value>::clear()
+{
+    for (int b = 0; b < N_BUCKETS; b++)
+        buckets[b].clear();
+    last = 0;
+    count = 0;
+    topBucket = -1;
+}
+
+/*
+ * toString(): the items bucket by bucket, [(key,value),...]
+ *      only bucket 0 is in order: the rest is not sorted
+ */
+template <class Key, class Value>
+string RadixHeap<Key, Value>::toString(string (*value2str)(Value &))
+{
+    stringstream os;
+    os << "[";
+    bool first = true;
+    for (int b = 0; b < N_BUCKETS; b++)
+        for (int idx = 0; idx < buckets[b].size(); idx++)
+        {
+            Entry &entry = buckets[b].get(idx);
+            if (!first)
+                os << ",";
+            first = false;
+            os << "(" << entry.key << ",";
+            if (value2str != 0)
+                os << value2str(entry.value);
+            else
+                os << entry.value;
+            os << ")";
+        }
+    os << "]";
+    return os.str();
+}
+
+//////////////////////////////////////////////////////////////////////
+//////////////////////// (private) METHOD DEFNITION //////////////////
+//////////////////////////////////////////////////////////////////////
+
+/*
+ * refill(): make bucket 0 non-empty (count > 0)
+ *      last = the smallest key of the first non-empty bucket b,
+ *      then every item of b has a new bucket < b
+ */
+template <class Key, class Value>
+void RadixHeap<Key, Value>::refill()
+{
+    if (!buckets[0].empty())
+        return;
+    topBucket = -1; // the items move
+    int b = 1;
+    while (buckets[b].empty())
+        b++;
+    XArrayList<Entry> &source = buckets[b];
+    Key smallest = source.get(0).key;
+    for (int idx = 1; idx < source.size(); idx++)
+        if (source.get(idx).key < smallest)
+            smallest = source.get(idx).key;
+    last = smallest;
+    while (!source.empty())
+    {
+        Entry entry = source.removeAt(source.size() - 1); // O(1): no shift, capacity kept
+        buckets[bucketOf(entry.key)].add(std::move(entry));
+    }
+}
+
+/*
+ * top(): the smallest item (count > 0), nothing moved
+ */
+template <class Key, class Value>
+typename RadixHeap<Key, Value>::Entry &RadixHeap<Key, Value>::top()
+{
+    if (!buckets[0].empty())
+        return buckets[0].get(buckets[0].size() - 1);
+    if (topBucket == -1)
+    {
+        int b = 1;
+        while (buckets[b].empty())
+            b++;
+        topBucket = b;
+        topIndex = 0;
+        for (int idx = 1; idx < buckets[b].size(); idx++)
+            if (buckets[b].get(idx).key < buckets[b].get(topIndex).key)
+                topIndex = idx;
+    }
+    return buckets[topBucket].get(topIndex);
+}
+
+#endif /* RADIXHEAP_H */
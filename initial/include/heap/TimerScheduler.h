@@ -0,0 +1,491 @@
+#ifndef TIMERSCHEDULER_H
+#define TIMERSCHEDULER_H
+#include "heap/Heap.h"
+#include "list/XArrayList.h"
+#include "util/MemLib.h"
+#include <iostream>
+#include <stdexcept>
+using namespace std;
+/*
+ * TimerScheduler<T>: timers (deadline, item) expiring in batches
+ *  + time: integer ticks; advance(time, expired) moves the clock forward
+ *      and appends the items of all expired timers to "expired"
+ *  + near deadlines: a hierarchical timing wheel of "levels" levels,
+ *      256 slots each; level l covers the deadlines whose highest bit
+ *      differing from now is in bits [8l, 8l+8)
+ *      => the wheel covers about 256^levels ticks ahead (2^32 by default)
+ *  + far deadlines: a Heap, moved to the wheel once they come into range
+ *  + schedule: O(1) (wheel), cancel: O(1);
+ *      a timer goes down one level at most "levels" times (cascade)
+ *  + advance: ticks without a due slot are skipped, the cost depends on
+ *      the timers and the slots scanned, not on the number of ticks
+ *
+ * Handles: index of the timer in a node pool + generation counter
+ *      the generation changes when a node is freed: a handle of an expired
+ *      or cancelled timer is never confused with a new timer in the same node.
+ *      Far timers are cancelled lazily: their heap entry is skipped later;
+ *      once the cancelled entries outnumber the live ones, the far heap is
+ *      rebuilt from the live entries (memory bounded by the live timers).
+ *
+ * Example:
+ *  TimerScheduler<int> timers;
+ *  long long handle = timers.schedule(100, reservationId);
+ *  timers.cancel(handle);
+ *  XArrayList<int> expired;
+ *  timers.advance(now, expired);
+ */
+template <class T>
+class TimerScheduler
+{
+public:
+    class Node;     // forward declaration
+    class FarEntry; // forward declaration
+
+protected:
+    static const int SLOT_BITS = 8;
+    static const int N_SLOTS = 1 << SLOT_BITS;
+
+    Node *nodes;           // node pool
+    int capacity;          // size of the node pool
+    int freeHead;          // free nodes, linked by next (-1: none)
+    int *heads;            // levels * N_SLOTS lists of nodes (-1: empty)
+    int levels;            // number of levels of the wheel
+    int wheelCount;        // timers in the wheel
+    Heap<FarEntry> far;    // timers beyond the wheel
+    int farStale;          // entries of far whose timer was cancelled
+    int count;             // scheduled timers (not expired, not cancelled)
+    long long now;         // current time
+
+public:
+    TimerScheduler(long long now = 0, int levels = 4);
+    ~TimerScheduler();
+
+    long long schedule(long long deadline, T item);
+    bool cancel(long long handle);
+    bool isScheduled(long long handle);
+    int advance(long long time, XArrayList<T> &expired);
+    long long getNow();
+    int size();
+    bool empty();
+    int farEntries();
+
+private:
+    TimerScheduler(const TimerScheduler<T> &scheduler);
+    TimerScheduler<T> &operator=(const TimerScheduler<T> &scheduler);
+
+    static long long makeHandle(int index, int generation)
+    {
+        return ((long long)generation << 32) | (unsigned int)index;
+    }
+    static int farComparator(FarEntry &lhs, FarEntry &rhs)
+    {
+        if (lhs.deadline < rhs.deadline)
+            return -1;
+        else if (lhs.deadline > rhs.deadline)
+            return +1;
+        else
+            return 0;
+    }
+    /*
+     * levelOf(deadline): level of the highest bit differing from now,
+     *      levels if the deadline is beyond the wheel
+     */
+    int levelOf(long long deadline)
+    {
+        unsigned long long diff = (unsigned long long)(deadline ^ now);
+        int level = 0;
+        while (level < levels && (diff >> (SLOT_BITS * (level + 1))) != 0)
+            level++;
+        return level;
+    }
+
+    int allocNode();
+    void freeNode(int index);
+    void place(int index);
+    void link(int index, int slot);
+    void unlink(int index);
+    void cascade(int level);
+    void pullFar();
+    void popStale();
+    void compactFar();
+    long long nextDue();
+    void tick(XArrayList<T> &expired);
+
+    //////////////////////////////////////////////////////////////////////
+    ////////////////////////  INNER CLASSES DEFNITION ////////////////////
+    //////////////////////////////////////////////////////////////////////
+public:
+    class Node
+    {
+    public:
+        T item;
+        long long deadline;
+        int prev, next;     // neighbours in the slot (next: in the free list)
+        int generation = 0; // see above
+        int slot = -2;      // >= 0: slot of the wheel, -1: far heap, -2: free
+    };
+
+    class FarEntry
+    {
+    public:
+        long long deadline;
+        int index;
+        int generation;
+
+        bool operator<(const FarEntry &other) const { return deadline < other.deadline; }
+        bool operator>(const FarEntry &other) const { return deadline > other.deadline; }
+        friend ostream &operator<<(ostream &os, const FarEntry &entry)
+        {
+            os << "(" << entry.deadline << "," << entry.index << ")";
+            return os;
+        }
+    };
+};
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////     METHOD DEFNITION      ///////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T>
+TimerScheduler<T>::TimerScheduler(long long now, int levels)
+    : far(&TimerScheduler<T>::farComparator)
+{
+    if (levels < 1 || levels > 7)
+        throw std::invalid_argument("Number of levels must be in [1, 7].");
+    this->now = now;
+    this->levels = levels;
+    this->capacity = 16;
+    this->nodes = new Node[capacity];
+    for (int idx = 0; idx < capacity; idx++)
+        nodes[idx].next = idx + 1 < capacity ? idx + 1 : -1;
+    this->freeHead = 0;
+    this->heads = new int[levels * N_SLOTS];
+    for (int slot = 0; slot < levels * N_SLOTS; slot++)
+        heads[slot] = -1;
+    this->wheelCount = 0;
+    this->farStale = 0;
+    this->count = 0;
+}
+
+template <class T>
+TimerScheduler<T>::~TimerScheduler()
+{
+    delete[] nodes;
+    delete[] heads;
+}
+
+/*
+ * schedule(deadline, item): return the handle of the timer
+ *      a deadline not after now expires at the next tick
+ */
+template <class T>
+long long TimerScheduler<T>::schedule(long long deadline, T item)
+{
+    int index = allocNode();
+    Node &node = nodes[index];
+    node.item = std::move(item);
+    node.deadline = deadline > now ? deadline : now + 1;
+    place(index);
+    count++;
+    return makeHandle(index, node.generation);
+}
+
+/*
+ * cancel(handle): return false if the timer already expired or was cancelled
+ */
+template <class T>
+bool TimerScheduler<T>::cancel(long long handle)
+{
+    if (!isScheduled(handle))
+        return false;
+    int index = (int)(handle & 0xFFFFFFFFLL);
+    bool inFar = nodes[index].slot == -1;
+    if (!inFar)
+        unlink(index);
+    // in far: the heap entry stays, skipped by pullFar (generation changed)
+    freeNode(index);
+    count--;
+    if (inFar)
+    {
+        farStale++;
+        if (farStale > 32 && 2 * farStale > far.size())
+            compactFar();
+    }
+    return true;
+}
+
+template <class T>
+bool TimerScheduler<T>::isScheduled(long long handle)
+{
+    int index = (int)(handle & 0xFFFFFFFFLL);
+    int generation = (int)(handle >> 32);
+    return index >= 0 && index < capacity &&
+           nodes[index].slot != -2 && nodes[index].generation == generation;
+}
+
+/*
+ * advance(time, expired): move the clock to time, return the number of
+ *      timers expired (appended to expired by deadline, any order for equal deadlines)
+ */
+template <class T>
+int TimerScheduler<T>::advance(long long time, XArrayList<T> &expired)
+{
+    int before = expired.size();
+    while (now < time)
+    {
+        if (wheelCount == 0)
+        {
+            // nothing to cascade or expire: jump to the tick before the next far timer
+            long long next = time;
+            popStale();
+            if (!far.empty())
+                next = min(time, far.peek().deadline - 1);
+            if (next > now)
+            {
+                now = next;
+                pullFar();
+                continue;
+            }
+        }
+        else
+        {
+            // empty ticks do nothing: jump to the tick before the next due slot
+            long long next = min(time, nextDue());
+            if (next - 1 > now)
+                now = next - 1;
+        }
+        now++;
+        tick(expired);
+    }
+    return expired.size() - before;
+}
+
+template <class T>
+long long TimerScheduler<T>::getNow()
+{
+    return now;
+}
+
+template <class T>
+int TimerScheduler<T>::size()
+{
+    return count;
+}
+
+template <class T>
+bool TimerScheduler<T>::empty()
+{
+    return count == 0;
+}
+
+/*
+ * farEntries(): entries of the far heap, cancelled ones not removed yet included
+ */
+template <class T>
+int TimerScheduler<T>::farEntries()
+{
+    return far.size();
+}
+
+//////////////////////////////////////////////////////////////////////
+//////////////////////// (private) METHOD DEFNITION //////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T>
+int TimerScheduler<T>::allocNode()
+{
+    if (freeHead == -1)
+    {
+        int newCapacity = capacity * 2;
+        Node *newNodes = new Node[newCapacity];
+        relocate(newNodes, nodes, capacity);
+        delete[] nodes;
+        nodes = newNodes;
+        for (int idx = capacity; idx < newCapacity; idx++)
+            nodes[idx].next = idx + 1 < newCapacity ? idx + 1 : -1;
+        freeHead = capacity;
+        capacity = newCapacity;
+    }
+    int index = freeHead;
+    freeHead = nodes[index].next;
+    return index;
+}
+
+template <class T>
+void TimerScheduler<T>::freeNode(int index)
+{
+    Node &node = nodes[index];
+    node.generation++;
+    node.slot = -2;
+    node.item = T();
+    node.next = freeHead;
+    freeHead = index;
+}
+
+/*
+ * place(index): the wheel slot or the far heap for the node's deadline
+ */
+template <class T>
+void TimerScheduler<T>::place(int index)
+{
+    Node &node = nodes[index];
+    int level = levelOf(node.deadline);
+    if (level == levels)
+    {
+        node.slot = -1;
+        far.push(FarEntry{node.deadline, index, node.generation});
+        return;
+    }
+    int slot = (int)((node.deadline >> (SLOT_BITS * level)) & (N_SLOTS - 1));
+    link(index, level * N_SLOTS + slot);
+}
+
+template <class T>
+void TimerScheduler<T>::link(int index, int slot)
+{
+    Node &node = nodes[index];
+    node.slot = slot;
+    node.prev = -1;
+    node.next = heads[slot];
+    if (heads[slot] != -1)
+        nodes[heads[slot]].prev = index;
+    heads[slot] = index;
+    wheelCount++;
+}
+
+template <class T>
+void TimerScheduler<T>::unlink(int index)
+{
+    Node &node = nodes[index];
+    if (node.prev != -1)
+        nodes[node.prev].next = node.next;
+    else
+        heads[node.slot] = node.next;
+    if (node.next != -1)
+        nodes[node.next].prev = node.prev;
+    wheelCount--;
+}
+
+/*
+ * cascade(level): the slot of level matching now is due:
+ *      its timers go to lower levels
+ */
+template <class T>
+void TimerScheduler<T>::cascade(int level)
+{
+    int slot = level * N_SLOTS + (int)((now >> (SLOT_BITS * level)) & (N_SLOTS - 1));
+    int index = heads[slot];
+    heads[slot] = -1;
+    while (index != -1)
+    {
+        int next = nodes[index].next;
+        wheelCount--;
+        place(index);
+        index = next;
+    }
+}
+
+/*
+ * pullFar(): far timers now in the range of the wheel go to the wheel
+ */
+template <class T>
+void TimerScheduler<T>::pullFar()
+{
+    while (!far.empty())
+    {
+        FarEntry entry = far.peek();
+        if (!isScheduled(makeHandle(entry.index, entry.generation)))
+        {
+            far.pop(); // cancelled
+            farStale--;
+            continue;
+        }
+        if (levelOf(entry.deadline) == levels)
+            break;
+        far.pop();
+        place(entry.index);
+    }
+}
+
+/*
+ * popStale(): remove the cancelled entries at the top of the far heap
+ */
+template <class T>
+void TimerScheduler<T>::popStale()
+{
+    while (!far.empty() && !isScheduled(makeHandle(far.peek().index, far.peek().generation)))
+    {
+        far.pop();
+        farStale--;
+    }
+}
+
+/*
+ * compactFar(): rebuild the far heap from its live entries, O(far.size())
+ *      once per far.size() / 2 cancels at least: amortized O(1) per cancel
+ */
+template <class T>
+void TimerScheduler<T>::compactFar()
+{
+    int live = 0;
+    FarEntry *entries = new FarEntry[far.size() - farStale];
+    for (typename Heap<FarEntry>::Iterator it = far.begin(); it != far.end(); it++)
+        if (isScheduled(makeHandle((*it).index, (*it).generation)))
+            entries[live++] = *it;
+    far.heapify(entries, live);
+    delete[] entries;
+    farStale = 0;
+}
+
+/*
+ * nextDue(): first tick after now with a non-empty slot due (wheelCount > 0)
+ *      a slot of level l past the current one is due when now reaches it
+ *      (bits below 8l all zero); the first level with such a slot gives the
+ *      earliest one, as the slots of level l all come before those of level l+1
+ */
+template <class T>
+long long TimerScheduler<T>::nextDue()
+{
+    for (int level = 0; level < levels; level++)
+    {
+        int shift = SLOT_BITS * level;
+        int current = (int)((now >> shift) & (N_SLOTS - 1));
+        for (int slot = current + 1; slot < N_SLOTS; slot++)
+            if (heads[level * N_SLOTS + slot] != -1)
+            {
+                long long block = now >> (shift + SLOT_BITS) << (shift + SLOT_BITS);
+                return block | ((long long)slot << shift);
+            }
+    }
+    return now + 1; // not reached: a timer of the wheel is past the current slot of its level
+}
+
+/*
+ * tick(expired): now has just moved by one tick
+ */
+template <class T>
+void TimerScheduler<T>::tick(XArrayList<T> &expired)
+{
+    int top = 0; // highest level whose slot is due: lower bits of now all zero
+    while (top + 1 < levels && (now & ((1LL << (SLOT_BITS * (top + 1))) - 1)) == 0)
+        top++;
+    if ((now & ((1LL << (SLOT_BITS * levels)) - 1)) == 0)
+        pullFar(); // the range of the wheel has moved
+    for (int level = top; level >= 1; level--)
+        cascade(level);
+
+    int slot = (int)(now & (N_SLOTS - 1));
+    int index = heads[slot];
+    heads[slot] = -1;
+    while (index != -1)
+    {
+        int next = nodes[index].next;
+        wheelCount--;
+        expired.add(std::move(nodes[index].item));
+        freeNode(index);
+        count--;
+        index = next;
+    }
+}
+
+#endif /* TIMERSCHEDULER_H */
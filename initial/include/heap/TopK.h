@@ -0,0 +1,246 @@
+#ifndef TOPK_H
+#define TOPK_H
+#include "list/XArrayList.h"
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+using namespace std;
+/*
+ * TopK<T>: keep the k best items of a stream in O(k) memory
+ *  + "best" follows the comparator convention of Heap<T>:
+ *      the k items a Heap<T> with the same comparator would pop first
+ *      (the k smallest by default; pass a max comparator to keep the k largest)
+ *  + internally a bounded heap whose root is the WORST retained item,
+ *      so an item that cannot enter the top-k is rejected with one comparison
+ *  + merge(other): combine partial results,
+ *      e.g. one TopK per thread over a part of the stream, then merge them
+ *
+ * Example:
+ *  TopK<int> top(10, &maxHeapComparator);  // the 10 largest
+ *  for(...) top.offer(value);
+ *  XArrayList<int> best = top.sorted();     // largest first
+ */
+template <class T>
+class TopK
+{
+protected:
+    T *elements;                       // bounded heap, the worst retained item at the root
+    int k;                             // maximum number of items retained
+    int count;                         // current count of items retained
+    int (*comparator)(T &lhs, T &rhs); // see above
+
+public:
+    TopK(int k, int (*comparator)(T &, T &) = 0);
+    TopK(const TopK<T> &topk);
+    TopK<T> &operator=(const TopK<T> &topk);
+    ~TopK();
+
+    bool offer(T item);
+    void offerAll(T array[], int size);
+    void merge(TopK<T> &other);
+    const T worst();
+    XArrayList<T> sorted();
+    int size();
+    int getK();
+    bool empty();
+    void clear();
+    string toString(string (*item2str)(T &) = 0);
+
+    void println(string (*item2str)(T &) = 0)
+    {
+        cout << toString(item2str) << endl;
+    }
+
+private:
+    /*
+     * worse(a, b): a comes after b in the order of the comparator
+     */
+    bool worse(T &a, T &b)
+    {
+        if (comparator != 0)
+            return comparator(a, b) > 0;
+        else
+            return b < a;
+    }
+    void reheapUp(int position);
+    void reheapDown(T *array, int size, int position);
+    void copyFrom(const TopK<T> &topk);
+};
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////     METHOD DEFNITION      ///////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T>
+TopK<T>::TopK(int k, int (*comparator)(T &, T &))
+{
+    if (k <= 0)
+        throw std::invalid_argument("k must be positive.");
+    this->k = k;
+    this->count = 0;
+    this->comparator = comparator;
+    this->elements = new T[k];
+}
+
+template <class T>
+TopK<T>::TopK(const TopK<T> &topk)
+{
+    copyFrom(topk);
+}
+
+template <class T>
+TopK<T> &TopK<T>::operator=(const TopK<T> &topk)
+{
+    if (this != &topk)
+    {
+        delete[] elements;
+        copyFrom(topk);
+    }
+    return *this;
+}
+
+template <class T>
+TopK<T>::~TopK()
+{
+    delete[] elements;
+}
+
+/*
+ * offer(item): return true if item is retained (for now) in the top-k
+ */
+template <class T>
+bool TopK<T>::offer(T item)
+{
+    if (count < k)
+    {
+        elements[count] = std::move(item);
+        reheapUp(count);
+        count++;
+        return true;
+    }
+    if (!worse(elements[0], item))
+        return false; // not better than the worst retained item
+    elements[0] = std::move(item);
+    reheapDown(elements, count, 0);
+    return true;
+}
+
+template <class T>
+void TopK<T>::offerAll(T array[], int size)
+{
+    for (int i = 0; i < size; i++)
+        offer(array[i]);
+}
+
+template <class T>
+void TopK<T>::merge(TopK<T> &other)
+{
+    for (int i = 0; i < other.count; i++)
+        offer(other.elements[i]);
+}
+
+template <class T>
+const T TopK<T>::worst()
+{
+    if (count == 0)
+        throw std::underflow_error("Calling to peek with the empty heap.");
+    return elements[0];
+}
+
+/*
+ * sorted(): the retained items, best first; the top-k itself is not changed
+ */
+template <class T>
+XArrayList<T> TopK<T>::sorted()
+{
+    XArrayList<T> result(0, 0, count > 0 ? count : 10);
+    for (int i = 0; i < count; i++)
+        result.add(elements[i]);
+    // in-place sort-down: the worst item goes to the end first
+    T *data = result.getData();
+    for (int last = count - 1; last > 0; last--)
+    {
+        std::swap(data[0], data[last]);
+        reheapDown(data, last, 0);
+    }
+    return result;
+}
+
+template <class T>
+int TopK<T>::size()
+{
+    return count;
+}
+
+template <class T>
+int TopK<T>::getK()
+{
+    return k;
+}
+
+template <class T>
+bool TopK<T>::empty()
+{
+    return count == 0;
+}
+
+template <class T>
+void TopK<T>::clear()
+{
+    delete[] elements;
+    elements = new T[k];
+    count = 0;
+}
+
+template <class T>
+string TopK<T>::toString(string (*item2str)(T &))
+{
+    return sorted().toString(item2str);
+}
+
+//////////////////////////////////////////////////////////////////////
+//////////////////////// (private) METHOD DEFNITION //////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T>
+void TopK<T>::reheapUp(int position)
+{
+    while (position > 0)
+    {
+        int parent = (position - 1) / 2;
+        if (!worse(elements[position], elements[parent]))
+            break;
+        std::swap(elements[position], elements[parent]);
+        position = parent;
+    }
+}
+
+template <class T>
+void TopK<T>::reheapDown(T *array, int size, int position)
+{
+    while (true)
+    {
+        int child = position * 2 + 1;
+        if (child >= size)
+            break;
+        if (child + 1 < size && worse(array[child + 1], array[child]))
+            child++;
+        if (!worse(array[child], array[position]))
+            break;
+        std::swap(array[child], array[position]);
+        position = child;
+    }
+}
+
+template <class T>
+void TopK<T>::copyFrom(const TopK<T> &topk)
+{
+    k = topk.k;
+    count = topk.count;
+    comparator = topk.comparator;
+    elements = new T[k];
+    for (int i = 0; i < count; i++)
+        elements[i] = topk.elements[i];
+}
+
+#endif /* TOPK_H */
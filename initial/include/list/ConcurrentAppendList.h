@@ -0,0 +1,285 @@
+#ifndef CONCURRENTAPPENDLIST_H
+#define CONCURRENTAPPENDLIST_H
+#include "list/XArrayList.h"
+#include "util/MemLib.h"
+#include <atomic>
+#include <thread>
+#include <stdexcept>
+using namespace std;
+/*
+ * ConcurrentAppendList<T>: a list many threads append to without a lock
+ *  + add(e): the slot is reserved by one atomic fetch_add,
+ *      then the item is written in place
+ *  + segments: segment k holds B * 2^k items (B: initial capacity rounded up
+ *      to a power of two); a segment is allocated by the first thread that
+ *      needs it (compare-exchange) and never moves
+ *  + size(): published size, the items [0, size()) are all written
+ *      each slot has a "ready" flag set after its item is written; a writer
+ *      then moves the published size over all ready slots (compare-exchange).
+ *      No writer waits for another one: a slow writer only delays the
+ *      published size until it sets its own flag.
+ *      => get(index) with index < size() is safe while other threads add
+ *  + moveTo(list): the items go to an XArrayList, without any copy if they
+ *      all fit in the first segment (reserve enough capacity up front);
+ *      a list with a memory resource gets the items moved one by one;
+ *      no add may run at the same time
+ *
+ * Example:
+ *  ConcurrentAppendList<Result> results(nTasks);
+ *  ... each thread: results.add(compute(task)); ...
+ *  XArrayList<Result> all;
+ *  results.moveTo(all);
+ */
+template <class T>
+class ConcurrentAppendList
+{
+protected:
+    static const int MAX_SEGMENTS = 32;
+
+    struct Segment
+    {
+        T *items;
+        atomic<unsigned char> *ready; // 1: item written
+    };
+    atomic<Segment *> segments[MAX_SEGMENTS]; // segment k: B * 2^k items, 0 until allocated
+    int baseBits;                             // B = 2^baseBits
+    atomic<long long> reserved;               // slots handed out by add
+    atomic<long long> published;              // slots [0, published) all written
+
+public:
+    ConcurrentAppendList(int initialCapacity = 16);
+    ~ConcurrentAppendList();
+
+    void add(T e);
+    T &get(long long index);
+    long long size();
+    bool empty();
+    void moveTo(XArrayList<T> &list);
+    int segmentCount();
+
+private:
+    ConcurrentAppendList(const ConcurrentAppendList<T> &list);
+    ConcurrentAppendList<T> &operator=(const ConcurrentAppendList<T> &list);
+
+    static int highestBit(unsigned long long value)
+    {
+        return 63 - __builtin_clzll(value);
+    }
+    long long segmentSize(int k)
+    {
+        return 1LL << (baseBits + k);
+    }
+    /*
+     * locate(index, offset): same mapping as SegmentedList, j = index + B:
+     *      segment highestBit(j) - baseBits, offset j - 2^highestBit(j)
+     */
+    int locate(long long index, long long &offset)
+    {
+        unsigned long long j = (unsigned long long)index + (1ULL << baseBits);
+        int high = highestBit(j);
+        offset = (long long)(j - (1ULL << high));
+        return high - baseBits;
+    }
+    T &at(long long index)
+    {
+        long long offset;
+        int k = locate(index, offset);
+        return segments[k].load(memory_order_acquire)->items[offset];
+    }
+    Segment *createSegment(int k)
+    {
+        Segment *segment = new Segment;
+        segment->items = new T[segmentSize(k)];
+        segment->ready = new atomic<unsigned char>[segmentSize(k)]();
+        return segment;
+    }
+    static void deleteSegment(Segment *segment)
+    {
+        if (segment == 0)
+            return;
+        delete[] segment->items;
+        delete[] segment->ready;
+        delete segment;
+    }
+    Segment *segmentFor(int k);
+    void publish();
+};
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////     METHOD DEFNITION      ///////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T>
+ConcurrentAppendList<T>::ConcurrentAppendList(int initialCapacity)
+    : reserved(0), published(0)
+{
+    if (initialCapacity <= 0)
+        throw std::invalid_argument("Initial capacity must be positive.");
+    baseBits = 0;
+    while ((1LL << baseBits) < initialCapacity)
+        baseBits++;
+    for (int k = 0; k < MAX_SEGMENTS; k++)
+        segments[k].store(0, memory_order_relaxed);
+    segments[0].store(createSegment(0), memory_order_release);
+}
+
+template <class T>
+ConcurrentAppendList<T>::~ConcurrentAppendList()
+{
+    for (int k = 0; k < MAX_SEGMENTS; k++)
+        deleteSegment(segments[k].load(memory_order_relaxed));
+}
+
+template <class T>
+void ConcurrentAppendList<T>::add(T e)
+{
+    long long index = reserved.fetch_add(1, memory_order_relaxed);
+    long long offset;
+    int k = locate(index, offset);
+    if (k >= MAX_SEGMENTS)
+        throw std::length_error("ConcurrentAppendList is full.");
+    Segment *segment = segmentFor(k);
+    segment->items[offset] = std::move(e);
+    segment->ready[offset].store(1, memory_order_release);
+    // full fence: the flag store must be visible before publish() reads the
+    // neighbour flags, or two adjacent writers can each miss the other's flag
+    // (release/acquire does not order a store before a later load)
+    atomic_thread_fence(memory_order_seq_cst);
+    publish();
+}
+
+/*
+ * get(index): index must be < size()
+ */
+template <class T>
+T &ConcurrentAppendList<T>::get(long long index)
+{
+    if (index < 0 || index >= size())
+        throw std::out_of_range("Index is out of range!");
+    return at(index);
+}
+
+template <class T>
+long long ConcurrentAppendList<T>::size()
+{
+    return published.load(memory_order_acquire);
+}
+
+template <class T>
+bool ConcurrentAppendList<T>::empty()
+{
+    return size() == 0;
+}
+
+/*
+ * moveTo(list): replace the items of list by the items of this list;
+ *      this list is empty afterwards (its first segment may be handed over)
+ */
+template <class T>
+void ConcurrentAppendList<T>::moveTo(XArrayList<T> &list)
+{
+    long long count = size();
+    if (count > 0x7FFFFFFFLL)
+        throw std::length_error("Too many items for an XArrayList.");
+    Segment *first = segments[0].load(memory_order_relaxed);
+    if (list.getResource() != 0)
+    {
+        // the list's array comes from its resource (adopt refuses it):
+        // the items are moved one by one into an array of the resource
+        list.clear();
+        list.reserve((int)count);
+        for (long long idx = 0; idx < count; idx++)
+            list.add(std::move(at(idx)));
+    }
+    else if (count <= segmentSize(0))
+    {
+        // one segment: the array itself becomes the list's array
+        list.adopt(first->items, (int)count, (int)segmentSize(0));
+        first->items = 0;
+    }
+    else
+    {
+        T *target = new T[count];
+        long long done = 0;
+        for (int k = 0; done < count; k++)
+        {
+            int n = (int)min(segmentSize(k), count - done);
+            relocate(target + done, segments[k].load(memory_order_relaxed)->items, n);
+            done += n;
+        }
+        try
+        {
+            list.adopt(target, (int)count, (int)count);
+        }
+        catch (...)
+        {
+            delete[] target;
+            throw;
+        }
+    }
+    for (int k = 0; k < MAX_SEGMENTS; k++)
+    {
+        deleteSegment(segments[k].load(memory_order_relaxed));
+        segments[k].store(0, memory_order_relaxed);
+    }
+    segments[0].store(createSegment(0), memory_order_relaxed);
+    reserved.store(0);
+    published.store(0);
+}
+
+/*
+ * segmentCount(): segments allocated so far
+ */
+template <class T>
+int ConcurrentAppendList<T>::segmentCount()
+{
+    int allocated = 0;
+    for (int k = 0; k < MAX_SEGMENTS; k++)
+        if (segments[k].load(memory_order_relaxed) != 0)
+            allocated++;
+    return allocated;
+}
+
+//////////////////////////////////////////////////////////////////////
+//////////////////////// (private) METHOD DEFNITION //////////////////
+//////////////////////////////////////////////////////////////////////
+
+/*
+ * segmentFor(k): segment k, allocated by the first thread needing it;
+ *      a thread losing the race deletes its own array
+ */
+template <class T>
+typename ConcurrentAppendList<T>::Segment *ConcurrentAppendList<T>::segmentFor(int k)
+{
+    Segment *segment = segments[k].load(memory_order_acquire);
+    if (segment != 0)
+        return segment;
+    Segment *created = createSegment(k);
+    if (segments[k].compare_exchange_strong(segment, created, memory_order_acq_rel, memory_order_acquire))
+        return created;
+    deleteSegment(created);
+    return segment; // set by the winner
+}
+
+/*
+ * publish(): move the published size over the ready slots;
+ *      any writer may do it for the others
+ */
+template <class T>
+void ConcurrentAppendList<T>::publish()
+{
+    long long next = published.load(memory_order_acquire);
+    while (next < reserved.load(memory_order_acquire))
+    {
+        long long offset;
+        Segment *segment = segments[locate(next, offset)].load(memory_order_acquire);
+        if (segment == 0 || segment->ready[offset].load(memory_order_acquire) == 0)
+            return; // its writer publishes it later: with the fence in add, at
+                    // least one of two neighbour writers sees the other's flag
+        // on failure, next = the value set by another writer
+        if (published.compare_exchange_weak(next, next + 1, memory_order_acq_rel, memory_order_acquire))
+            next++;
+    }
+}
+
+#endif /* CONCURRENTAPPENDLIST_H */
@@ -0,0 +1,470 @@
+/*
+ * File:   CowArrayList.h
+ */
+
+#ifndef COWARRAYLIST_H
+#define COWARRAYLIST_H
+#include "list/IList.h"
+#include "util/MemLib.h"
+#include <atomic>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+using namespace std;
+/*
+ * CowArrayList<T>: an array list whose copies share one array (copy-on-write)
+ *  + copy constructor, operator=: O(1), the array is shared and its
+ *      reference count goes up; no item is copied
+ *  + the first change of a shared list (add, removeAt, set, clear, get, ...)
+ *      copies the items into its own array ("detach"), the other copies
+ *      keep the old one
+ *  + read(index), size(), indexOf(), toString(): never copy
+ *      (get returns T&, the caller may change the item: it detaches)
+ *  + after get() or begin() the array is "unshareable" (as the old
+ *      copy-on-write strings): a T& handed out may still change it, so a
+ *      copy made later copies the items instead of sharing them; the array
+ *      becomes shareable again when it is replaced (growth, clear)
+ *  + the reference count is atomic: copies may be read and changed in
+ *      different threads, one list object must not be used by two threads
+ *  + deleteUserData is called by the last copy using an array; as for
+ *      XArrayList copies, a detached copy of pointer items deletes them too
+ *
+ * Example:
+ *  CowArrayList<Row> snapshot = rows;  // no copy
+ *  rows.add(row);                      // rows copies its items once
+ */
+template <class T>
+class CowArrayList : public IList<T>
+{
+public:
+    class Iterator; // forward declaration
+
+protected:
+    struct Buffer
+    {
+        T *data;             // new T[capacity]
+        int capacity;
+        atomic<int> refs;    // lists sharing the buffer
+        bool unshareable;    // a T& was handed out (get, begin): copies copy the items
+    };
+    Buffer *buffer;                             // 0 until the first add
+    int count;                                  // number of items stored in the list
+    bool (*itemEqual)(T &lhs, T &rhs);          // function pointer: test if two items (type: T&) are equal or not
+    void (*deleteUserData)(CowArrayList<T> *);  // function pointer: be called to remove items (if they are pointer type)
+
+public:
+    CowArrayList(
+        void (*deleteUserData)(CowArrayList<T> *) = 0,
+        bool (*itemEqual)(T &, T &) = 0);
+    CowArrayList(const CowArrayList<T> &list);
+    CowArrayList<T> &operator=(const CowArrayList<T> &list);
+    ~CowArrayList();
+
+    // Inherit from IList: BEGIN
+    void add(T e);
+    void add(int index, T e);
+    T removeAt(int index);
+    bool removeItem(T item, void (*removeItemData)(T) = 0);
+    bool empty();
+    int size();
+    void clear();
+    T &get(int index);
+    int indexOf(T item);
+    bool contains(T item);
+    string toString(string (*item2str)(T &) = 0);
+    // Inherit from IList: END
+
+    void set(int index, T value);
+    const T &read(int index) const;
+    int size() const
+    {
+        return count;
+    }
+    int getCapacity()
+    {
+        return buffer != 0 ? buffer->capacity : 0;
+    }
+    /*
+     * isShared(): true if another copy uses the same array
+     */
+    bool isShared()
+    {
+        return buffer != 0 && buffer->refs.load(memory_order_acquire) > 1;
+    }
+
+    void println(string (*item2str)(T &) = 0)
+    {
+        cout << toString(item2str) << endl;
+    }
+
+    Iterator begin()
+    {
+        detach();
+        if (buffer != 0)
+            buffer->unshareable = true;
+        return Iterator(this, 0);
+    }
+    Iterator end()
+    {
+        return Iterator(this, count);
+    }
+
+    static void free(CowArrayList<T> *list)
+    {
+        for (int idx = 0; idx < list->count; idx++)
+            delete list->buffer->data[idx];
+    }
+
+protected:
+    static bool equals(T &lhs, T &rhs, bool (*itemEqual)(T &, T &))
+    {
+        if (itemEqual == 0)
+            return lhs == rhs;
+        else
+            return itemEqual(lhs, rhs);
+    }
+    void checkIndex(int index) const;
+    static Buffer *newBuffer(int capacity);
+    static Buffer *share(Buffer *buffer, int count);
+    void detach();
+    void ensureCapacity(int index);
+    void release();
+
+    //////////////////////////////////////////////////////////////////////
+    ////////////////////////  INNER CLASSES DEFNITION ////////////////////
+    //////////////////////////////////////////////////////////////////////
+public:
+    // Iterator: BEGIN
+    class Iterator
+    {
+    private:
+        int cursor;
+        CowArrayList<T> *pList;
+
+    public:
+        Iterator(CowArrayList<T> *pList = 0, int index = 0)
+        {
+            this->pList = pList;
+            this->cursor = index;
+        }
+        Iterator &operator=(const Iterator &iterator)
+        {
+            cursor = iterator.cursor;
+            pList = iterator.pList;
+            return *this;
+        }
+        void remove(void (*removeItemData)(T) = 0)
+        {
+            T item = pList->removeAt(cursor);
+            if (removeItemData != 0)
+                removeItemData(item);
+            cursor -= 1; // MUST keep index of previous, for ++ later
+        }
+
+        T &operator*()
+        {
+            return pList->buffer->data[cursor]; // begin() detached the list
+        }
+        bool operator!=(const Iterator &iterator)
+        {
+            return cursor != iterator.cursor;
+        }
+        // Prefix ++ overload
+        Iterator &operator++()
+        {
+            this->cursor++;
+            return *this;
+        }
+        // Postfix ++ overload
+        Iterator operator++(int)
+        {
+            Iterator iterator = *this;
+            ++*this;
+            return iterator;
+        }
+    };
+    // Iterator: END
+};
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////     METHOD DEFNITION      ///////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T>
+CowArrayList<T>::CowArrayList(
+    void (*deleteUserData)(CowArrayList<T> *),
+    bool (*itemEqual)(T &, T &))
+{
+    this->buffer = 0;
+    this->count = 0;
+    this->itemEqual = itemEqual;
+    this->deleteUserData = deleteUserData;
+}
+
+template <class T>
+CowArrayList<T>::CowArrayList(const CowArrayList<T> &list)
+{
+    this->buffer = share(list.buffer, list.count);
+    this->count = list.count;
+    this->itemEqual = list.itemEqual;
+    this->deleteUserData = list.deleteUserData;
+}
+
+template <class T>
+CowArrayList<T> &CowArrayList<T>::operator=(const CowArrayList<T> &list)
+{
+    if (this == &list)
+        return *this;
+    Buffer *shared = share(list.buffer, list.count);
+    release();
+    buffer = shared;
+    count = list.count;
+    itemEqual = list.itemEqual;
+    deleteUserData = list.deleteUserData;
+    return *this;
+}
+
+template <class T>
+CowArrayList<T>::~CowArrayList()
+{
+    release();
+}
+
+template <class T>
+void CowArrayList<T>::add(T e)
+{
+    ensureCapacity(count);
+    buffer->data[count++] = std::move(e);
+}
+
+template <class T>
+void CowArrayList<T>::add(int index, T e)
+{
+    if (index < 0 || index > count)
+        throw std::out_of_range("Index is out of range!");
+    ensureCapacity(count);
+    T *data = buffer->data;
+    shiftItems(data + index + 1, data + index, count - index);
+    data[index] = std::move(e);
+    count++;
+}
+
+template <class T>
+T CowArrayList<T>::removeAt(int index)
+{
+    checkIndex(index);
+    detach();
+    T *data = buffer->data;
+    T result = std::move(data[index]);
+    shiftItems(data + index, data + index + 1, count - index - 1);
+    count--;
+    return result;
+}
+
+template <class T>
+bool CowArrayList<T>::removeItem(T item, void (*removeItemData)(T))
+{
+    int index = indexOf(item);
+    if (index == -1)
+        return false;
+    detach();
+    if (removeItemData)
+        removeItemData(buffer->data[index]);
+    removeAt(index);
+    return true;
+}
+
+template <class T>
+bool CowArrayList<T>::empty()
+{
+    return count == 0;
+}
+
+template <class T>
+int CowArrayList<T>::size()
+{
+    return count;
+}
+
+/*
+ * clear(): this list leaves its array (the other copies keep it)
+ */
+template <class T>
+void CowArrayList<T>::clear()
+{
+    release();
+    buffer = 0;
+    count = 0;
+}
+
+template <class T>
+T &CowArrayList<T>::get(int index)
+{
+    checkIndex(index);
+    detach();
+    buffer->unshareable = true;
+    return buffer->data[index];
+}
+
+template <class T>
+int CowArrayList<T>::indexOf(T item)
+{
+    for (int idx = 0; idx < count; idx++)
+        if (equals(buffer->data[idx], item, itemEqual))
+            return idx;
+    return -1;
+}
+
+template <class T>
+bool CowArrayList<T>::contains(T item)
+{
+    return indexOf(item) != -1;
+}
+
+template <class T>
+string CowArrayList<T>::toString(string (*item2str)(T &))
+{
+    ostringstream ss;
+    ss << "[";
+    for (int idx = 0; idx < count; idx++)
+    {
+        if (idx > 0)
+            ss << ", ";
+        if (item2str)
+            ss << item2str(buffer->data[idx]);
+        else
+            ss << buffer->data[idx];
+    }
+    ss << "]";
+    return ss.str();
+}
+
+/*
+ * set(index, value): as SegmentedList::set, index == size() appends
+ */
+template <class T>
+void CowArrayList<T>::set(int index, T value)
+{
+    if (index == count)
+    {
+        add(std::move(value));
+        return;
+    }
+    checkIndex(index);
+    detach();
+    buffer->data[index] = std::move(value);
+}
+
+/*
+ * read(index): the item at index, without detaching
+ */
+template <class T>
+const T &CowArrayList<T>::read(int index) const
+{
+    checkIndex(index);
+    return buffer->data[index];
+}
+
+//////////////////////////////////////////////////////////////////////
+//////////////////////// (private) METHOD DEFNITION //////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T>
+void CowArrayList<T>::checkIndex(int index) const
+{
+    if (index < 0 || index >= count)
+        throw std::out_of_range("Index is out of range!");
+}
+
+template <class T>
+typename CowArrayList<T>::Buffer *CowArrayList<T>::newBuffer(int capacity)
+{
+    Buffer *created = new Buffer;
+    created->capacity = capacity;
+    created->data = new T[capacity];
+    created->refs.store(1, memory_order_relaxed);
+    created->unshareable = false;
+    return created;
+}
+
+/*
+ * share(buffer, count): the buffer for a new copy: buffer itself, or a
+ *      copy of its count items if it is unshareable
+ */
+template <class T>
+typename CowArrayList<T>::Buffer *CowArrayList<T>::share(Buffer *buffer, int count)
+{
+    if (buffer == 0)
+        return 0;
+    if (buffer->unshareable)
+    {
+        Buffer *own = newBuffer(buffer->capacity);
+        copyItems(own->data, buffer->data, count);
+        return own;
+    }
+    buffer->refs.fetch_add(1, memory_order_relaxed);
+    return buffer;
+}
+
+/*
+ * detach(): make the array owned by this list only
+ */
+template <class T>
+void CowArrayList<T>::detach()
+{
+    if (!isShared())
+        return;
+    Buffer *own = newBuffer(buffer->capacity);
+    copyItems(own->data, buffer->data, count);
+    release();
+    buffer = own;
+}
+
+/*
+ * ensureCapacity(index): make slot index usable in an array of this list only;
+ *      a shared array is copied and grown at the same time
+ */
+template <class T>
+void CowArrayList<T>::ensureCapacity(int index)
+{
+    if (buffer != 0 && index < buffer->capacity)
+    {
+        detach();
+        return;
+    }
+    int newCapacity = buffer != 0 ? buffer->capacity * 2 : 10;
+    while (newCapacity <= index)
+        newCapacity *= 2;
+    Buffer *grown = newBuffer(newCapacity);
+    if (isShared())
+    {
+        copyItems(grown->data, buffer->data, count);
+        release();
+    }
+    else if (buffer != 0)
+    {
+        relocate(grown->data, buffer->data, count);
+        delete[] buffer->data;
+        delete buffer;
+    }
+    buffer = grown;
+}
+
+/*
+ * release(): drop this list's reference; the last one deletes the array
+ */
+template <class T>
+void CowArrayList<T>::release()
+{
+    if (buffer == 0)
+        return;
+    if (buffer->refs.fetch_sub(1, memory_order_acq_rel) == 1)
+    {
+        if (deleteUserData != 0)
+            deleteUserData(this);
+        delete[] buffer->data;
+        delete buffer;
+    }
+}
+
+#endif /* COWARRAYLIST_H */
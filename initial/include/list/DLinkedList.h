@@ -6,6 +6,7 @@
  #define DLINKEDLIST_H
  
  #include "list/IList.h"
+ #include "util/MemLib.h"
  
  #include <sstream>
  #include <iostream>
@@ -26,11 +27,13 @@
      int count;
      bool (*itemEqual)(T &lhs, T &rhs);        // function pointer: test if two items (type: T&) are equal or not
      void (*deleteUserData)(DLinkedList<T> *); // function pointer: be called to remove items (if they are pointer type)
+     pmr::memory_resource *resource;           // memory of the nodes (0: new/delete), see util/MemoryResource.h
  
  public:
      DLinkedList(
          void (*deleteUserData)(DLinkedList<T> *) = 0,
-         bool (*itemEqual)(T &, T &) = 0);
+         bool (*itemEqual)(T &, T &) = 0,
+         pmr::memory_resource *resource = 0);
      DLinkedList(const DLinkedList<T> &list);
      DLinkedList<T> &operator=(const DLinkedList<T> &list);
      ~DLinkedList();
@@ -202,7 +205,7 @@
              Node *pNext = pNode->prev; // MUST prev, so iterator++ will go to end
              if (removeItemData != 0)
                  removeItemData(pNode->data);
-             delete pNode;
+             deleteObject(pList->resource, pNode);
              pNode = pNext;
              pList->count -= 1;
          }
@@ -279,7 +282,7 @@ class BWDIterator{
         if(removeItemData){
             removeItemData(pNode->data);
         }
-        delete pNode;
+        deleteObject(pList ? pList->resource : 0, pNode);
         pNode = pNext;
         if(pList){
             pList->count -= 1;
@@ -302,13 +305,15 @@ class BWDIterator{
  template <class T>
  DLinkedList<T>::DLinkedList(
      void (*deleteUserData)(DLinkedList<T> *),
-     bool (*itemEqual)(T &, T &))
+     bool (*itemEqual)(T &, T &),
+     pmr::memory_resource *resource)
  {
      // TODO
      this->setDeleteUserDataPtr(deleteUserData);
      this->itemEqual =  itemEqual;
-     this->head = new Node();
-     this->tail = new Node();
+     this->resource = resource;
+     this->head = newObject<Node>(resource);
+     this->tail = newObject<Node>(resource);
      head->next = tail;
      tail->prev = head;
      this->count = 0;
@@ -319,6 +324,7 @@ class BWDIterator{
  {
      // TODO
 
+        this->resource = 0; // as std::pmr containers: a copy does not take the resource
         this->head = new Node();
         this->tail = new Node();
         head->next = tail;     
@@ -348,15 +354,15 @@ class BWDIterator{
  {
      // TODO
      removeInternalData();
-     delete head;
-    delete tail;
+     deleteObject(resource, head);
+    deleteObject(resource, tail);
  }
  
  template <class T>
  void DLinkedList<T>::add(T e)
  {
      // TODO
-     Node * newNode  = new Node(e);
+     Node * newNode  = newObject<Node>(resource, e);
      
      newNode->next = tail;
      newNode->prev =  tail->prev;
@@ -376,7 +382,7 @@ class BWDIterator{
         add(e);
         return;
      }
-     Node *newNode = new Node(e);
+     Node *newNode = newObject<Node>(resource, e);
     Node* temp = head;                
     for (int i = 0; i <= index; i++) {
         temp = temp->next;
@@ -423,7 +429,7 @@ T DLinkedList<T>::removeAt(int index) {
     T result = target->data;
     target->prev->next = target->next;
     target->next->prev = target->prev;
-    delete target;
+    deleteObject(resource, target);
     count--;
 
     return result;
@@ -596,7 +602,7 @@ void DLinkedList<T>::set(int index, T value)
      while(curr != tail){
          Node *del = curr;
          curr= curr->next;
-         delete del;
+         deleteObject(resource, del);
      }
      head->next = tail;
      tail->prev = head;
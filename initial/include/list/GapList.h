@@ -0,0 +1,405 @@
+/*
+ * File:   GapList.h
+ */
+
+#ifndef GAPLIST_H
+#define GAPLIST_H
+#include "list/IList.h"
+#include "util/MemLib.h"
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+using namespace std;
+/*
+ * GapList<T>: an array list with a gap (free slots) at the last edit point
+ *
+ *      data: [ items 0..gapStart-1 | gap | items gapStart..count-1 ]
+ *                                  ^gapStart ^gapEnd
+ *
+ *  + add(index, e), removeAt(index): the gap is moved to index first
+ *      (shifting only the items between the old and the new position),
+ *      then the edit is O(1)
+ *      => k edits around one position: O(k + distance moved), not O(k * n)
+ *  + get(index): O(1), one more comparison than XArrayList
+ *  + gap empty: the array is re-allocated (capacity x2), the gap
+ *      stays at the edit point
+ */
+template <class T>
+class GapList : public IList<T>
+{
+public:
+    class Iterator; // forward declaration
+
+protected:
+    T *data;                              // items and gap
+    int capacity;                         // size of data
+    int gapStart;                         // first slot of the gap = logical index of the gap
+    int gapEnd;                           // first slot after the gap
+    bool (*itemEqual)(T &lhs, T &rhs);    // function pointer: test if two items (type: T&) are equal or not
+    void (*deleteUserData)(GapList<T> *); // function pointer: be called to remove items (if they are pointer type)
+
+public:
+    GapList(
+        void (*deleteUserData)(GapList<T> *) = 0,
+        bool (*itemEqual)(T &, T &) = 0,
+        int capacity = 10);
+    GapList(const GapList<T> &list);
+    GapList<T> &operator=(const GapList<T> &list);
+    ~GapList();
+
+    // Inherit from IList: BEGIN
+    void add(T e);
+    void add(int index, T e);
+    T removeAt(int index);
+    bool removeItem(T item, void (*removeItemData)(T) = 0);
+    bool empty();
+    int size();
+    void clear();
+    T &get(int index);
+    int indexOf(T item);
+    bool contains(T item);
+    string toString(string (*item2str)(T &) = 0);
+    // Inherit from IList: END
+
+    void set(int index, T value);
+    int getCapacity()
+    {
+        return capacity;
+    }
+    /*
+     * getGapIndex(): logical index of the gap (where the next edit is O(1))
+     */
+    int getGapIndex()
+    {
+        return gapStart;
+    }
+
+    void println(string (*item2str)(T &) = 0)
+    {
+        cout << toString(item2str) << endl;
+    }
+
+    Iterator begin()
+    {
+        return Iterator(this, 0);
+    }
+    Iterator end()
+    {
+        return Iterator(this, size());
+    }
+
+    static void free(GapList<T> *list)
+    {
+        for (int idx = 0; idx < list->size(); idx++)
+            delete list->at(idx);
+    }
+
+protected:
+    int gapLength()
+    {
+        return gapEnd - gapStart;
+    }
+    /*
+     * at(index): the item at logical index, no check
+     */
+    T &at(int index)
+    {
+        return index < gapStart ? data[index] : data[index + gapEnd - gapStart];
+    }
+    static bool equals(T &lhs, T &rhs, bool (*itemEqual)(T &, T &))
+    {
+        if (itemEqual == 0)
+            return lhs == rhs;
+        else
+            return itemEqual(lhs, rhs);
+    }
+    void checkIndex(int index);
+    void moveGap(int index);
+    void grow();
+    void copyFrom(const GapList<T> &list);
+
+    //////////////////////////////////////////////////////////////////////
+    ////////////////////////  INNER CLASSES DEFNITION ////////////////////
+    //////////////////////////////////////////////////////////////////////
+public:
+    // Iterator: BEGIN
+    class Iterator
+    {
+    private:
+        int cursor;
+        GapList<T> *pList;
+
+    public:
+        Iterator(GapList<T> *pList = 0, int index = 0)
+        {
+            this->pList = pList;
+            this->cursor = index;
+        }
+        Iterator &operator=(const Iterator &iterator)
+        {
+            cursor = iterator.cursor;
+            pList = iterator.pList;
+            return *this;
+        }
+        void remove(void (*removeItemData)(T) = 0)
+        {
+            T item = pList->removeAt(cursor);
+            if (removeItemData != 0)
+                removeItemData(item);
+            cursor -= 1; // MUST keep index of previous, for ++ later
+        }
+
+        T &operator*()
+        {
+            return pList->at(cursor);
+        }
+        bool operator!=(const Iterator &iterator)
+        {
+            return cursor != iterator.cursor;
+        }
+        // Prefix ++ overload
+        Iterator &operator++()
+        {
+            this->cursor++;
+            return *this;
+        }
+        // Postfix ++ overload
+        Iterator operator++(int)
+        {
+            Iterator iterator = *this;
+            ++*this;
+            return iterator;
+        }
+    };
+    // Iterator: END
+};
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////     METHOD DEFNITION      ///////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T>
+GapList<T>::GapList(
+    void (*deleteUserData)(GapList<T> *),
+    bool (*itemEqual)(T &, T &),
+    int capacity)
+{
+    this->capacity = capacity > 0 ? capacity : 10;
+    this->data = new T[this->capacity];
+    this->gapStart = 0;
+    this->gapEnd = this->capacity;
+    this->itemEqual = itemEqual;
+    this->deleteUserData = deleteUserData;
+}
+
+template <class T>
+GapList<T>::GapList(const GapList<T> &list)
+{
+    copyFrom(list);
+}
+
+template <class T>
+GapList<T> &GapList<T>::operator=(const GapList<T> &list)
+{
+    if (this == &list)
+        return *this;
+    if (deleteUserData != 0)
+        deleteUserData(this);
+    delete[] data;
+    copyFrom(list);
+    return *this;
+}
+
+template <class T>
+GapList<T>::~GapList()
+{
+    if (deleteUserData != 0)
+        deleteUserData(this);
+    delete[] data;
+}
+
+template <class T>
+void GapList<T>::add(T e)
+{
+    add(size(), std::move(e));
+}
+
+template <class T>
+void GapList<T>::add(int index, T e)
+{
+    if (index < 0 || index > size())
+        throw std::out_of_range("Index is out of range!");
+    moveGap(index);
+    if (gapLength() == 0)
+        grow();
+    data[gapStart++] = std::move(e);
+}
+
+template <class T>
+T GapList<T>::removeAt(int index)
+{
+    checkIndex(index);
+    moveGap(index);
+    // the item at index is the first one after the gap
+    return std::move(data[gapEnd++]);
+}
+
+template <class T>
+bool GapList<T>::removeItem(T item, void (*removeItemData)(T))
+{
+    int index = indexOf(item);
+    if (index == -1)
+        return false;
+    if (removeItemData)
+        removeItemData(at(index));
+    removeAt(index);
+    return true;
+}
+
+template <class T>
+bool GapList<T>::empty()
+{
+    return size() == 0;
+}
+
+template <class T>
+int GapList<T>::size()
+{
+    return capacity - gapLength();
+}
+
+template <class T>
+void GapList<T>::clear()
+{
+    if (deleteUserData != 0)
+        deleteUserData(this);
+    delete[] data;
+    capacity = 10;
+    data = new T[capacity];
+    gapStart = 0;
+    gapEnd = capacity;
+}
+
+template <class T>
+T &GapList<T>::get(int index)
+{
+    checkIndex(index);
+    return at(index);
+}
+
+template <class T>
+int GapList<T>::indexOf(T item)
+{
+    // two contiguous parts: before and after the gap
+    for (int idx = 0; idx < gapStart; idx++)
+        if (equals(data[idx], item, itemEqual))
+            return idx;
+    for (int idx = gapEnd; idx < capacity; idx++)
+        if (equals(data[idx], item, itemEqual))
+            return idx - gapLength();
+    return -1;
+}
+
+template <class T>
+bool GapList<T>::contains(T item)
+{
+    return indexOf(item) != -1;
+}
+
+template <class T>
+string GapList<T>::toString(string (*item2str)(T &))
+{
+    ostringstream ss;
+    ss << "[";
+    for (int idx = 0; idx < size(); idx++)
+    {
+        if (idx > 0)
+            ss << ", ";
+        if (item2str)
+            ss << item2str(at(idx));
+        else
+            ss << at(idx);
+    }
+    ss << "]";
+    return ss.str();
+}
+
+/*
+ * set(index, value): replace the item at index (the gap does not move);
+ *      as SegmentedList::set, index == size() appends
+ */
+template <class T>
+void GapList<T>::set(int index, T value)
+{
+    if (index == size())
+    {
+        add(std::move(value));
+        return;
+    }
+    checkIndex(index);
+    at(index) = std::move(value);
+}
+
+//////////////////////////////////////////////////////////////////////
+//////////////////////// (private) METHOD DEFNITION //////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T>
+void GapList<T>::checkIndex(int index)
+{
+    if (index < 0 || index >= size())
+        throw std::out_of_range("Index is out of range!");
+}
+
+/*
+ * moveGap(index): the gap starts at logical index afterwards
+ */
+template <class T>
+void GapList<T>::moveGap(int index)
+{
+    if (index < gapStart)
+    {
+        // items [index, gapStart) go after the gap
+        int n = gapStart - index;
+        shiftItems(data + gapEnd - n, data + index, n);
+        gapStart -= n;
+        gapEnd -= n;
+    }
+    else if (index > gapStart)
+    {
+        // items after the gap, up to logical index, go before the gap
+        int n = index - gapStart;
+        shiftItems(data + gapStart, data + gapEnd, n);
+        gapStart += n;
+        gapEnd += n;
+    }
+}
+
+template <class T>
+void GapList<T>::grow()
+{
+    int newCapacity = capacity * 2;
+    T *newData = new T[newCapacity];
+    int after = capacity - gapEnd;
+    relocate(newData, data, gapStart);
+    relocate(newData + newCapacity - after, data + gapEnd, after);
+    delete[] data;
+    data = newData;
+    gapEnd = newCapacity - after;
+    capacity = newCapacity;
+}
+
+template <class T>
+void GapList<T>::copyFrom(const GapList<T> &list)
+{
+    capacity = list.capacity;
+    gapStart = list.gapStart;
+    gapEnd = list.gapEnd;
+    itemEqual = list.itemEqual;
+    deleteUserData = 0; // the items belong to the other list
+    data = new T[capacity];
+    copyItems(data, list.data, gapStart);
+    copyItems(data + gapEnd, list.data + gapEnd, capacity - gapEnd);
+}
+
+#endif /* GAPLIST_H */
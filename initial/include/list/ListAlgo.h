@@ -0,0 +1,336 @@
+#ifndef LISTALGO_H
+#define LISTALGO_H
+#include "list/XArrayList.h"
+#include "list/DLinkedList.h"
+#include "heap/KWayMerger.h"
+#include "util/MemLib.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory.h>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+using namespace std;
+/*
+ * Sorting and searching on lists
+ *
+ * function pointer: int (*comparator)(T& lhs, T& rhs)
+ *      same convention as Heap<T>: negative if lhs comes first;
+ *      no comparator: operators < and >
+ * nThreads: 0 = one thread per hardware thread (std::thread::hardware_concurrency)
+ *
+ * parallelMergeSort(list or array, comparator, nThreads): stable, O(n log n)
+ *  + each thread stable-sorts one chunk of n / nThreads items
+ *  + splitters picked from regular samples of the sorted chunks cut every chunk
+ *      into nThreads slices; thread t merges the slices t of all chunks
+ *      (KWayMerger) into its own part of the output: no locking
+ *
+ * radixSort(list or array, nThreads): LSD radix sort, 8-bit digits, stable
+ *  + T: integral or floating-point type (the key is the item itself)
+ *  + sizeof(T) passes at most; a pass where all items share the digit is skipped
+ *  + each pass: per-thread histograms, then each thread scatters its chunk
+ *  + floating point: -0.0 before 0.0, NaN after +infinity (-NaN before -infinity)
+ *
+ * lowerBound(list, item, comparator): index of the first item not before item
+ *      (size() if none); the list must be sorted by comparator
+ *  + XArrayList, arrays: binary search on the contiguous items, O(log n)
+ *  + DLinkedList: O(log n) comparisons, O(n) steps of the iterator
+ * binarySearch(list, item, comparator): index of an item equal to item, -1 if none
+ */
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  HELPERS  ///////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+/*
+ * ComparatorOf<T>::type: the comparator parameter; T is taken from the list only,
+ *      so a lambda converts to it
+ */
+template <class T>
+struct ComparatorOf
+{
+    typedef int (*type)(T &, T &);
+};
+
+inline int listAlgoThreads(int nThreads)
+{
+    if (nThreads > 0)
+        return nThreads;
+    int hardware = (int)std::thread::hardware_concurrency();
+    return hardware > 0 ? hardware : 1;
+}
+
+template <class T>
+inline int listAlgoCompare(int (*comparator)(T &, T &), T &lhs, T &rhs)
+{
+    if (comparator != 0)
+        return comparator(lhs, rhs);
+    if (lhs < rhs)
+        return -1;
+    else if (lhs > rhs)
+        return 1;
+    else
+        return 0;
+}
+
+/*
+ * runInThreads(nThreads, task): task(0) .. task(nThreads - 1),
+ *      task(0) in the calling thread
+ */
+template <class Task>
+inline void runInThreads(int nThreads, Task task)
+{
+    vector<std::thread> threads;
+    for (int t = 1; t < nThreads; t++)
+        threads.emplace_back(task, t);
+    task(0);
+    for (std::thread &thread : threads)
+        thread.join();
+}
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  SEARCH  ////////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T>
+int lowerBound(T *array, int size, T item, typename ComparatorOf<T>::type comparator = 0)
+{
+    int first = 0, count = size;
+    while (count > 0)
+    {
+        int step = count / 2;
+        if (listAlgoCompare(comparator, array[first + step], item) < 0)
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+        else
+            count = step;
+    }
+    return first;
+}
+
+template <class T>
+int lowerBound(XArrayList<T> &list, T item, typename ComparatorOf<T>::type comparator = 0)
+{
+    return lowerBound(list.getData(), list.size(), item, comparator);
+}
+
+template <class T>
+int lowerBound(DLinkedList<T> &list, T item, typename ComparatorOf<T>::type comparator = 0)
+{
+    // same loop, but "first" is an iterator moved step by step
+    typename DLinkedList<T>::Iterator first = list.begin();
+    int index = 0, count = list.size();
+    while (count > 0)
+    {
+        int step = count / 2;
+        typename DLinkedList<T>::Iterator middle = first;
+        for (int i = 0; i < step; i++)
+            ++middle;
+        if (listAlgoCompare(comparator, *middle, item) < 0)
+        {
+            first = ++middle;
+            index += step + 1;
+            count -= step + 1;
+        }
+        else
+            count = step;
+    }
+    return index;
+}
+
+template <class T>
+int binarySearch(T *array, int size, T item, typename ComparatorOf<T>::type comparator = 0)
+{
+    int index = lowerBound(array, size, item, comparator);
+    if (index < size && listAlgoCompare(comparator, array[index], item) == 0)
+        return index;
+    return -1;
+}
+
+template <class T>
+int binarySearch(XArrayList<T> &list, T item, typename ComparatorOf<T>::type comparator = 0)
+{
+    return binarySearch(list.getData(), list.size(), item, comparator);
+}
+
+template <class T>
+int binarySearch(DLinkedList<T> &list, T item, typename ComparatorOf<T>::type comparator = 0)
+{
+    int index = lowerBound(list, item, comparator);
+    if (index < list.size() && listAlgoCompare(comparator, list.get(index), item) == 0)
+        return index;
+    return -1;
+}
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  PARALLEL MERGESORT  ////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T>
+void parallelMergeSort(T *array, int size, typename ComparatorOf<T>::type comparator = 0, int nThreads = 0)
+{
+    int p = min(listAlgoThreads(nThreads), max(1, size / 1024)); // at least 1024 items per thread
+    XArrayListLess<T> less{comparator};
+    if (p == 1)
+    {
+        std::stable_sort(array, array + size, less);
+        return;
+    }
+
+    // 1. sort p chunks
+    vector<int> chunkFirst(p + 1);
+    for (int c = 0; c <= p; c++)
+        chunkFirst[c] = (int)((long long)size * c / p);
+    runInThreads(p, [&](int c)
+                 { std::stable_sort(array + chunkFirst[c], array + chunkFirst[c + 1], less); });
+
+    // 2. splitters: p regular samples per chunk, sorted, every p-th one
+    vector<T> samples;
+    for (int c = 0; c < p; c++)
+    {
+        int chunkSize = chunkFirst[c + 1] - chunkFirst[c];
+        for (int s = 0; s < p; s++)
+            samples.push_back(array[chunkFirst[c] + (int)((long long)chunkSize * s / p)]);
+    }
+    std::stable_sort(samples.begin(), samples.end(), less);
+    // cut[c][t]: first item of chunk c going to thread t (cut[c][p]: end of chunk c)
+    vector<vector<int>> cut(p, vector<int>(p + 1));
+    for (int c = 0; c < p; c++)
+    {
+        cut[c][0] = chunkFirst[c];
+        cut[c][p] = chunkFirst[c + 1];
+        for (int t = 1; t < p; t++)
+            cut[c][t] = chunkFirst[c] + lowerBound(array + chunkFirst[c], chunkFirst[c + 1] - chunkFirst[c],
+                                                   samples[t * p], comparator);
+    }
+
+    // 3. thread t merges slice t of every chunk at its offset in the output
+    T *output = new T[size];
+    runInThreads(p, [&](int t)
+                 {
+                     int offset = 0;
+                     for (int c = 0; c < p; c++)
+                         offset += cut[c][t] - chunkFirst[c];
+                     KWayMerger<T> merger(comparator);
+                     for (int c = 0; c < p; c++)
+                         merger.addRun(array + cut[c][t], cut[c][t + 1] - cut[c][t]);
+                     while (merger.hasNext())
+                         output[offset++] = merger.next(); });
+    relocate(array, output, size);
+    delete[] output;
+}
+
+template <class T>
+void parallelMergeSort(XArrayList<T> &list, typename ComparatorOf<T>::type comparator = 0, int nThreads = 0)
+{
+    parallelMergeSort(list.getData(), list.size(), comparator, nThreads);
+}
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  RADIX SORT  ////////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+/*
+ * RadixKeyType<T>, radixKey(item): unsigned key with the same order as the items
+ */
+template <class T, int size = sizeof(T)>
+struct RadixKeyType;
+template <class T>
+struct RadixKeyType<T, 1>
+{
+    typedef uint8_t type;
+};
+template <class T>
+struct RadixKeyType<T, 2>
+{
+    typedef uint16_t type;
+};
+template <class T>
+struct RadixKeyType<T, 4>
+{
+    typedef uint32_t type;
+};
+template <class T>
+struct RadixKeyType<T, 8>
+{
+    typedef uint64_t type;
+};
+
+template <class T>
+inline typename RadixKeyType<T>::type radixKey(T item)
+{
+    typedef typename RadixKeyType<T>::type Key;
+    const Key signBit = (Key)1 << (sizeof(Key) * 8 - 1);
+    Key bits;
+    memcpy(&bits, &item, sizeof(Key));
+    if constexpr (is_floating_point<T>::value)
+        return (bits & signBit) ? (Key)~bits : (Key)(bits | signBit);
+    else if constexpr (is_signed<T>::value)
+        return (Key)(bits ^ signBit);
+    else
+        return bits;
+}
+
+template <class T>
+void radixSort(T *array, int size, int nThreads = 1)
+{
+    static_assert(is_arithmetic<T>::value && !is_same<T, bool>::value,
+                  "radixSort: T must be an integral or floating-point type.");
+    const int RADIX = 256;
+    int p = min(listAlgoThreads(nThreads), max(1, size / 65536)); // small arrays: one thread
+    vector<int> chunkFirst(p + 1);
+    for (int c = 0; c <= p; c++)
+        chunkFirst[c] = (int)((long long)size * c / p);
+
+    T *buffer = new T[size];
+    T *source = array, *target = buffer;
+    vector<int> counts(p * RADIX); // counts[t * RADIX + digit]
+    for (int pass = 0; pass < (int)sizeof(T); pass++)
+    {
+        int shift = pass * 8;
+        std::fill(counts.begin(), counts.end(), 0);
+        runInThreads(p, [&](int t)
+                     {
+                         int *count = &counts[t * RADIX];
+                         for (int i = chunkFirst[t]; i < chunkFirst[t + 1]; i++)
+                             count[(radixKey(source[i]) >> shift) & (RADIX - 1)]++; });
+
+        // all items with the same digit: nothing to do in this pass
+        int digit0 = size > 0 ? (int)((radixKey(source[0]) >> shift) & (RADIX - 1)) : 0;
+        int sameDigit = 0;
+        for (int t = 0; t < p; t++)
+            sameDigit += counts[t * RADIX + digit0];
+        if (sameDigit == size)
+            continue;
+
+        // offsets: by digit, then by thread (keeps the sort stable)
+        int offset = 0;
+        for (int digit = 0; digit < RADIX; digit++)
+            for (int t = 0; t < p; t++)
+            {
+                int count = counts[t * RADIX + digit];
+                counts[t * RADIX + digit] = offset;
+                offset += count;
+            }
+        runInThreads(p, [&](int t)
+                     {
+                         int *next = &counts[t * RADIX];
+                         for (int i = chunkFirst[t]; i < chunkFirst[t + 1]; i++)
+                             target[next[(radixKey(source[i]) >> shift) & (RADIX - 1)]++] = source[i]; });
+        std::swap(source, target);
+    }
+    if (source != array)
+        memcpy(array, source, size * sizeof(T));
+    delete[] buffer;
+}
+
+template <class T>
+void radixSort(XArrayList<T> &list, int nThreads = 1)
+{
+    radixSort(list.getData(), list.size(), nThreads);
+}
+
+#endif /* LISTALGO_H */
@@ -0,0 +1,496 @@
+/*
+ * File:   PackedList.h
+ */
+
+#ifndef PACKEDLIST_H
+#define PACKEDLIST_H
+#include "list/IList.h"
+#include <cstdint>
+#include <memory.h>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+using namespace std;
+/*
+ * PackedList<Bits>: a list of small unsigned values (0 .. 2^Bits - 1),
+ *      Bits = 1, 2, 4 or 8, packed in 64-bit words (64 / Bits values per word)
+ *  + flags: PackedList<1> uses 1 bit per item (XArrayList<bool>: 8 bits,
+ *      XArrayList<int>: 32 bits); small enumerations: PackedList<2>, <4>
+ *  + indexOf, count, countRange: one word (64 / Bits items) per step;
+ *      a field equal to the value is found without a loop over the fields
+ *      (SWAR "zero field" test on word ^ value), the matches are counted
+ *      with popcount
+ *  + fill(from, to, value): whole words written at once
+ *  + get(index) returns a reference to a copy of the item (a field is not
+ *      addressable), as List1DAdapter does: change items with set(index, value)
+ *
+ * Example:
+ *  PackedList<1> inStock;          // one bit per product
+ *  inStock.fill(0, n, 1);
+ *  int available = inStock.count(1);
+ */
+template <int Bits>
+class PackedList : public IList<int>
+{
+    static_assert(Bits == 1 || Bits == 2 || Bits == 4 || Bits == 8,
+                  "PackedList: Bits must be 1, 2, 4 or 8.");
+
+public:
+    static const int PER_WORD = 64 / Bits;                 // items per word
+    static const uint64_t FIELD = (1ULL << Bits) - 1;      // mask of one item
+    static const int MAX_VALUE = (int)FIELD;
+
+    class Iterator; // forward declaration
+
+protected:
+    uint64_t *words;   // item i: bits [(i % PER_WORD) * Bits, +Bits) of words[i / PER_WORD]
+    int capacity;      // number of words; the fields past itemCount are 0
+    int itemCount;     // number of items stored in the list
+    int tempValue;     // returned by get
+
+public:
+    PackedList(int capacity = 10);
+    PackedList(const PackedList<Bits> &list);
+    PackedList<Bits> &operator=(const PackedList<Bits> &list);
+    ~PackedList();
+
+    // Inherit from IList: BEGIN
+    void add(int e);
+    void add(int index, int e);
+    int removeAt(int index);
+    bool removeItem(int item, void (*removeItemData)(int) = 0);
+    bool empty();
+    int size();
+    void clear();
+    int &get(int index);
+    int indexOf(int item);
+    bool contains(int item);
+    string toString(string (*item2str)(int &) = 0);
+    // Inherit from IList: END
+
+    void set(int index, int value);
+    int count(int value);
+    int countRange(int from, int to, int value);
+    void fill(int from, int to, int value);
+    /*
+     * memoryBytes(): size of the word array
+     */
+    long long memoryBytes()
+    {
+        return (long long)capacity * sizeof(uint64_t);
+    }
+
+    void println(string (*item2str)(int &) = 0)
+    {
+        cout << toString(item2str) << endl;
+    }
+
+    Iterator begin()
+    {
+        return Iterator(this, 0);
+    }
+    Iterator end()
+    {
+        return Iterator(this, itemCount);
+    }
+
+protected:
+    int at(int index)
+    {
+        return (int)((words[index / PER_WORD] >> (index % PER_WORD * Bits)) & FIELD);
+    }
+    void put(int index, int value)
+    {
+        int shift = index % PER_WORD * Bits;
+        uint64_t &word = words[index / PER_WORD];
+        word = (word & ~(FIELD << shift)) | ((uint64_t)value << shift);
+    }
+    /*
+     * broadcast(value): value in every field of a word
+     */
+    static uint64_t broadcast(int value)
+    {
+        return (~0ULL / FIELD) * (uint64_t)value;
+    }
+    /*
+     * matches(word, value): the highest bit of each field equal to value, 0 elsewhere
+     *      x = word ^ broadcast(value) has a zero field where the item equals value;
+     *      (x & low) + low sets the high bit of every non-zero field without a
+     *      carry into the next field (low: all bits but the high one of each field)
+     */
+    static uint64_t matches(uint64_t word, int value)
+    {
+        const uint64_t high = broadcast(1 << (Bits - 1));
+        const uint64_t low = ~high;
+        uint64_t x = word ^ broadcast(value);
+        return ~(((x & low) + low) | x | low);
+    }
+    /*
+     * fieldMask(from, to): bits of the fields [from, to) of one word, 0 <= from <= to <= PER_WORD
+     */
+    static uint64_t fieldMask(int from, int to)
+    {
+        uint64_t below = to == PER_WORD ? ~0ULL : (1ULL << (to * Bits)) - 1;
+        return below & ~((1ULL << (from * Bits)) - 1);
+    }
+    static int wordsFor(int items)
+    {
+        return (items + PER_WORD - 1) / PER_WORD;
+    }
+    void checkIndex(int index);
+    void checkValue(int value);
+    void checkRange(int from, int to);
+    void ensureCapacity(int items);
+
+    //////////////////////////////////////////////////////////////////////
+    ////////////////////////  INNER CLASSES DEFNITION ////////////////////
+    //////////////////////////////////////////////////////////////////////
+public:
+    // Iterator: BEGIN
+    class Iterator
+    {
+    private:
+        int cursor;
+        PackedList<Bits> *pList;
+
+    public:
+        Iterator(PackedList<Bits> *pList = 0, int index = 0)
+        {
+            this->pList = pList;
+            this->cursor = index;
+        }
+        Iterator &operator=(const Iterator &iterator)
+        {
+            cursor = iterator.cursor;
+            pList = iterator.pList;
+            return *this;
+        }
+        void remove(void (*removeItemData)(int) = 0)
+        {
+            int item = pList->removeAt(cursor);
+            if (removeItemData != 0)
+                removeItemData(item);
+            cursor -= 1; // MUST keep index of previous, for ++ later
+        }
+
+        int operator*()
+        {
+            return pList->at(cursor);
+        }
+        bool operator!=(const Iterator &iterator)
+        {
+            return cursor != iterator.cursor;
+        }
+        // Prefix ++ overload
+        Iterator &operator++()
+        {
+            this->cursor++;
+            return *this;
+        }
+        // Postfix ++ overload
+        Iterator operator++(int)
+        {
+            Iterator iterator = *this;
+            ++*this;
+            return iterator;
+        }
+    };
+    // Iterator: END
+};
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////     METHOD DEFNITION      ///////////////////
+//////////////////////////////////////////////////////////////////////
+
+/*
+ * PackedList(capacity): room for capacity items before the first re-allocation
+ */
+template <int Bits>
+PackedList<Bits>::PackedList(int capacity)
+{
+    this->capacity = wordsFor(capacity > 0 ? capacity : 10);
+    this->words = new uint64_t[this->capacity]();
+    this->itemCount = 0;
+    this->tempValue = 0;
+}
+
+template <int Bits>
+PackedList<Bits>::PackedList(const PackedList<Bits> &list)
+{
+    capacity = list.capacity;
+    itemCount = list.itemCount;
+    tempValue = 0;
+    words = new uint64_t[capacity];
+    memcpy(words, list.words, capacity * sizeof(uint64_t));
+}
+
+template <int Bits>
+PackedList<Bits> &PackedList<Bits>::operator=(const PackedList<Bits> &list)
+{
+    if (this == &list)
+        return *this;
+    delete[] words;
+    capacity = list.capacity;
+    itemCount = list.itemCount;
+    words = new uint64_t[capacity];
+    memcpy(words, list.words, capacity * sizeof(uint64_t));
+    return *this;
+}
+
+template <int Bits>
+PackedList<Bits>::~PackedList()
+{
+    delete[] words;
+}
+
+template <int Bits>
+void PackedList<Bits>::add(int e)
+{
+    checkValue(e);
+    ensureCapacity(itemCount + 1);
+    put(itemCount++, e);
+}
+
+/*
+ * add(index, e): the items from index move up by one field,
+ *      a whole word per step (the top field goes to the next word)
+ */
+template <int Bits>
+void PackedList<Bits>::add(int index, int e)
+{
+    if (index < 0 || index > itemCount)
+        throw std::out_of_range("Index is out of range!");
+    checkValue(e);
+    ensureCapacity(itemCount + 1);
+    int first = index / PER_WORD;
+    for (int w = wordsFor(itemCount + 1) - 1; w > first; w--)
+        words[w] = (words[w] << Bits) | (words[w - 1] >> (64 - Bits));
+    uint64_t keep = fieldMask(0, index % PER_WORD);
+    words[first] = (words[first] & keep) | ((words[first] << Bits) & ~keep);
+    put(index, e);
+    itemCount++;
+}
+
+/*
+ * removeAt(index): the items after index move down by one field
+ */
+template <int Bits>
+int PackedList<Bits>::removeAt(int index)
+{
+    checkIndex(index);
+    int result = at(index);
+    int first = index / PER_WORD, last = wordsFor(itemCount) - 1;
+    uint64_t keep = fieldMask(0, index % PER_WORD);
+    uint64_t carry = first < last ? words[first + 1] << (64 - Bits) : 0;
+    words[first] = (words[first] & keep) | ((words[first] >> Bits) & ~keep) | carry;
+    for (int w = first + 1; w <= last; w++)
+        words[w] = (words[w] >> Bits) | (w < last ? words[w + 1] << (64 - Bits) : 0);
+    itemCount--;
+    return result;
+}
+
+template <int Bits>
+bool PackedList<Bits>::removeItem(int item, void (*removeItemData)(int))
+{
+    int index = indexOf(item);
+    if (index == -1)
+        return false;
+    if (removeItemData)
+        removeItemData(at(index));
+    removeAt(index);
+    return true;
+}
+
+template <int Bits>
+bool PackedList<Bits>::empty()
+{
+    return itemCount == 0;
+}
+
+template <int Bits>
+int PackedList<Bits>::size()
+{
+    return itemCount;
+}
+
+template <int Bits>
+void PackedList<Bits>::clear()
+{
+    delete[] words;
+    capacity = wordsFor(10);
+    words = new uint64_t[capacity]();
+    itemCount = 0;
+}
+
+/*
+ * get(index): reference to a copy of the item, valid until the next get
+ */
+template <int Bits>
+int &PackedList<Bits>::get(int index)
+{
+    checkIndex(index);
+    tempValue = at(index);
+    return tempValue;
+}
+
+template <int Bits>
+int PackedList<Bits>::indexOf(int item)
+{
+    if (item < 0 || item > MAX_VALUE)
+        return -1;
+    int nWords = wordsFor(itemCount);
+    for (int w = 0; w < nWords; w++)
+    {
+        uint64_t found = matches(words[w], item);
+        if (w == nWords - 1)
+            found &= fieldMask(0, itemCount - w * PER_WORD); // the 0 fields past itemCount
+        if (found != 0)
+            return w * PER_WORD + __builtin_ctzll(found) / Bits;
+    }
+    return -1;
+}
+
+template <int Bits>
+bool PackedList<Bits>::contains(int item)
+{
+    return indexOf(item) != -1;
+}
+
+template <int Bits>
+string PackedList<Bits>::toString(string (*item2str)(int &))
+{
+    ostringstream ss;
+    ss << "[";
+    for (int idx = 0; idx < itemCount; idx++)
+    {
+        if (idx > 0)
+            ss << ", ";
+        int item = at(idx);
+        if (item2str)
+            ss << item2str(item);
+        else
+            ss << item;
+    }
+    ss << "]";
+    return ss.str();
+}
+
+/*
+ * set(index, value): as SegmentedList::set, index == size() appends
+ */
+template <int Bits>
+void PackedList<Bits>::set(int index, int value)
+{
+    if (index == itemCount)
+    {
+        add(value);
+        return;
+    }
+    checkIndex(index);
+    checkValue(value);
+    put(index, value);
+}
+
+/*
+ * count(value): number of items equal to value
+ */
+template <int Bits>
+int PackedList<Bits>::count(int value)
+{
+    return countRange(0, itemCount, value);
+}
+
+/*
+ * countRange(from, to, value): number of items equal to value in [from, to)
+ */
+template <int Bits>
+int PackedList<Bits>::countRange(int from, int to, int value)
+{
+    checkRange(from, to);
+    if (value < 0 || value > MAX_VALUE || from == to)
+        return 0;
+    int first = from / PER_WORD, last = (to - 1) / PER_WORD;
+    int total = 0;
+    for (int w = first; w <= last; w++)
+    {
+        uint64_t found = matches(words[w], value);
+        if (w == first || w == last)
+            found &= fieldMask(w == first ? from % PER_WORD : 0,
+                               w == last ? to - w * PER_WORD : PER_WORD);
+        total += __builtin_popcountll(found);
+    }
+    return total;
+}
+
+/*
+ * fill(from, to, value): items [from, to) = value; to may be past the end
+ *      (the list grows to "to" items)
+ */
+template <int Bits>
+void PackedList<Bits>::fill(int from, int to, int value)
+{
+    if (from < 0 || from > itemCount || to < from)
+        throw std::out_of_range("Index is out of range!");
+    checkValue(value);
+    if (from == to)
+        return;
+    ensureCapacity(to);
+    if (to > itemCount)
+        itemCount = to;
+    uint64_t all = broadcast(value);
+    int first = from / PER_WORD, last = (to - 1) / PER_WORD;
+    for (int w = first; w <= last; w++)
+    {
+        uint64_t mask = ~0ULL;
+        if (w == first || w == last)
+            mask = fieldMask(w == first ? from % PER_WORD : 0,
+                             w == last ? to - w * PER_WORD : PER_WORD);
+        words[w] = (words[w] & ~mask) | (all & mask);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+//////////////////////// (private) METHOD DEFNITION //////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <int Bits>
+void PackedList<Bits>::checkIndex(int index)
+{
+    if (index < 0 || index >= itemCount)
+        throw std::out_of_range("Index is out of range!");
+}
+
+template <int Bits>
+void PackedList<Bits>::checkValue(int value)
+{
+    if (value < 0 || value > MAX_VALUE)
+        throw std::invalid_argument("Value does not fit in the field.");
+}
+
+template <int Bits>
+void PackedList<Bits>::checkRange(int from, int to)
+{
+    if (from < 0 || to > itemCount || from > to)
+        throw std::out_of_range("Index is out of range!");
+}
+
+/*
+ * ensureCapacity(items): room for "items" items (capacity x2)
+ */
+template <int Bits>
+void PackedList<Bits>::ensureCapacity(int items)
+{
+    int needed = wordsFor(items);
+    if (needed <= capacity)
+        return;
+    int newCapacity = capacity * 2;
+    while (newCapacity < needed)
+        newCapacity *= 2;
+    uint64_t *newWords = new uint64_t[newCapacity]();
+    memcpy(newWords, words, capacity * sizeof(uint64_t));
+    delete[] words;
+    words = newWords;
+    capacity = newCapacity;
+}
+
+#endif /* PACKEDLIST_H */
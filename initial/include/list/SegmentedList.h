@@ -0,0 +1,436 @@
+/*
+ * File:   SegmentedList.h
+ */
+
+#ifndef SEGMENTEDLIST_H
+#define SEGMENTEDLIST_H
+#include "list/IList.h"
+#include <memory.h>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+using namespace std;
+/*
+ * SegmentedList<T>: an array list made of chunks that never move
+ *  + chunk k holds B * 2^k items (B = 2^baseBits, 16 by default):
+ *      B, 2B, 4B, ...: after k chunks the capacity is B * (2^k - 1)
+ *  + a small directory holds the chunk pointers;
+ *      only the directory is re-allocated when it is full
+ *  + get(i): O(1), with j = i + B:
+ *      chunk k = floor(log2 j) - baseBits, offset = j - 2^(k + baseBits)
+ *  + add(e) allocates a new chunk when needed and never moves an item:
+ *      the references returned by get stay valid while items are appended
+ *      (add(index, e) and removeAt shift the items after index, as XArrayList)
+ *  + memory: no re-allocation peak (XArrayList: old + new array while growing)
+ */
+template <class T>
+class SegmentedList : public IList<T>
+{
+public:
+    class Iterator; // forward declaration
+
+protected:
+    T **chunks;                                 // directory: chunks[k] holds B * 2^k items
+    int nChunks;                                // number of chunks allocated
+    int dirCapacity;                            // size of the directory
+    int baseBits;                               // B = 2^baseBits
+    int capacity;                               // B * (2^nChunks - 1)
+    int count;                                  // number of items stored in the list
+    bool (*itemEqual)(T &lhs, T &rhs);          // function pointer: test if two items (type: T&) are equal or not
+    void (*deleteUserData)(SegmentedList<T> *); // function pointer: be called to remove items (if they are pointer type)
+
+public:
+    SegmentedList(
+        void (*deleteUserData)(SegmentedList<T> *) = 0,
+        bool (*itemEqual)(T &, T &) = 0,
+        int baseBits = 4);
+    SegmentedList(const SegmentedList<T> &list);
+    SegmentedList<T> &operator=(const SegmentedList<T> &list);
+    ~SegmentedList();
+
+    // Inherit from IList: BEGIN
+    void add(T e);
+    void add(int index, T e);
+    T removeAt(int index);
+    bool removeItem(T item, void (*removeItemData)(T) = 0);
+    bool empty();
+    int size();
+    void clear();
+    T &get(int index);
+    int indexOf(T item);
+    bool contains(T item);
+    string toString(string (*item2str)(T &) = 0);
+    // Inherit from IList: END
+
+    void set(int index, T value);
+    void reserve(int minCapacity);
+    int getCapacity()
+    {
+        return capacity;
+    }
+    /*
+     * memoryBytes(): bytes of the chunks and the directory
+     */
+    long long memoryBytes()
+    {
+        return (long long)capacity * sizeof(T) + (long long)dirCapacity * sizeof(T *);
+    }
+
+    void println(string (*item2str)(T &) = 0)
+    {
+        cout << toString(item2str) << endl;
+    }
+
+    Iterator begin()
+    {
+        return Iterator(this, 0);
+    }
+    Iterator end()
+    {
+        return Iterator(this, count);
+    }
+
+    static void free(SegmentedList<T> *list)
+    {
+        for (int idx = 0; idx < list->count; idx++)
+            delete list->at(idx);
+    }
+
+protected:
+    /*
+     * at(index): the item at index, no check
+     */
+    T &at(int index)
+    {
+        unsigned int j = (unsigned int)index + (1u << baseBits);
+        int high = highestBit(j);
+        return chunks[high - baseBits][j - (1u << high)];
+    }
+    static int highestBit(unsigned int value)
+    {
+#if defined(__GNUC__)
+        return 31 - __builtin_clz(value);
+#else
+        int bit = -1;
+        for (; value != 0; value >>= 1)
+            bit++;
+        return bit;
+#endif
+    }
+    static bool equals(T &lhs, T &rhs, bool (*itemEqual)(T &, T &))
+    {
+        if (itemEqual == 0)
+            return lhs == rhs;
+        else
+            return itemEqual(lhs, rhs);
+    }
+    void checkIndex(int index);
+    void addChunk();
+    void removeInternalData();
+    void copyFrom(const SegmentedList<T> &list);
+
+    //////////////////////////////////////////////////////////////////////
+    ////////////////////////  INNER CLASSES DEFNITION ////////////////////
+    //////////////////////////////////////////////////////////////////////
+public:
+    // Iterator: BEGIN
+    class Iterator
+    {
+    private:
+        int cursor;
+        SegmentedList<T> *pList;
+
+    public:
+        Iterator(SegmentedList<T> *pList = 0, int index = 0)
+        {
+            this->pList = pList;
+            this->cursor = index;
+        }
+        Iterator &operator=(const Iterator &iterator)
+        {
+            cursor = iterator.cursor;
+            pList = iterator.pList;
+            return *this;
+        }
+        void remove(void (*removeItemData)(T) = 0)
+        {
+            T item = pList->removeAt(cursor);
+            if (removeItemData != 0)
+                removeItemData(item);
+            cursor -= 1; // MUST keep index of previous, for ++ later
+        }
+
+        T &operator*()
+        {
+            return pList->at(cursor);
+        }
+        bool operator!=(const Iterator &iterator)
+        {
+            return cursor != iterator.cursor;
+        }
+        // Prefix ++ overload
+        Iterator &operator++()
+        {
+            this->cursor++;
+            return *this;
+        }
+        // Postfix ++ overload
+        Iterator operator++(int)
+        {
+            Iterator iterator = *this;
+            ++*this;
+            return iterator;
+        }
+    };
+    // Iterator: END
+};
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////     METHOD DEFNITION      ///////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T>
+SegmentedList<T>::SegmentedList(
+    void (*deleteUserData)(SegmentedList<T> *),
+    bool (*itemEqual)(T &, T &),
+    int baseBits)
+{
+    if (baseBits < 0 || baseBits > 20)
+        throw std::invalid_argument("baseBits must be in [0, 20].");
+    this->baseBits = baseBits;
+    this->dirCapacity = 4;
+    this->chunks = new T *[dirCapacity];
+    this->nChunks = 0;
+    this->capacity = 0;
+    this->count = 0;
+    this->itemEqual = itemEqual;
+    this->deleteUserData = deleteUserData;
+}
+
+template <class T>
+SegmentedList<T>::SegmentedList(const SegmentedList<T> &list)
+{
+    copyFrom(list);
+}
+
+template <class T>
+SegmentedList<T> &SegmentedList<T>::operator=(const SegmentedList<T> &list)
+{
+    if (this != &list)
+    {
+        removeInternalData();
+        copyFrom(list);
+    }
+    return *this;
+}
+
+template <class T>
+SegmentedList<T>::~SegmentedList()
+{
+    removeInternalData();
+}
+
+template <class T>
+void SegmentedList<T>::add(T e)
+{
+    if (count == capacity)
+        addChunk();
+    at(count) = std::move(e);
+    count++;
+}
+
+template <class T>
+void SegmentedList<T>::add(int index, T e)
+{
+    if (index < 0 || index > count)
+        throw std::out_of_range("Index is out of range!");
+    if (count == capacity)
+        addChunk();
+    for (int i = count; i > index; i--)
+        at(i) = std::move(at(i - 1));
+    at(index) = std::move(e);
+    count++;
+}
+
+template <class T>
+T SegmentedList<T>::removeAt(int index)
+{
+    checkIndex(index);
+    T result = std::move(at(index));
+    for (int i = index; i < count - 1; i++)
+        at(i) = std::move(at(i + 1));
+    count--;
+    return result;
+}
+
+template <class T>
+bool SegmentedList<T>::removeItem(T item, void (*removeItemData)(T))
+{
+    int index = indexOf(item);
+    if (index == -1)
+        return false;
+    if (removeItemData)
+        removeItemData(at(index));
+    removeAt(index);
+    return true;
+}
+
+template <class T>
+bool SegmentedList<T>::empty()
+{
+    return count == 0;
+}
+
+template <class T>
+int SegmentedList<T>::size()
+{
+    return count;
+}
+
+template <class T>
+void SegmentedList<T>::clear()
+{
+    removeInternalData();
+    dirCapacity = 4;
+    chunks = new T *[dirCapacity];
+    nChunks = 0;
+    capacity = 0;
+    count = 0;
+}
+
+template <class T>
+T &SegmentedList<T>::get(int index)
+{
+    checkIndex(index);
+    return at(index);
+}
+
+template <class T>
+int SegmentedList<T>::indexOf(T item)
+{
+    // chunk by chunk: no index computation per item
+    int index = 0;
+    for (int k = 0; k < nChunks && index < count; k++)
+    {
+        T *chunk = chunks[k];
+        int chunkSize = 1 << (baseBits + k);
+        for (int offset = 0; offset < chunkSize && index < count; offset++, index++)
+            if (equals(chunk[offset], item, itemEqual))
+                return index;
+    }
+    return -1;
+}
+
+template <class T>
+bool SegmentedList<T>::contains(T item)
+{
+    return indexOf(item) != -1;
+}
+
+template <class T>
+string SegmentedList<T>::toString(string (*item2str)(T &))
+{
+    ostringstream ss;
+    ss << "[";
+    for (int idx = 0; idx < count; idx++)
+    {
+        if (idx > 0)
+            ss << ", ";
+        if (item2str)
+            ss << item2str(at(idx));
+        else
+            ss << at(idx);
+    }
+    ss << "]";
+    return ss.str();
+}
+
+/*
+ * set(index, value): as XArrayList::set, index == size() appends
+ */
+template <class T>
+void SegmentedList<T>::set(int index, T value)
+{
+    if (index == count)
+    {
+        add(std::move(value));
+        return;
+    }
+    checkIndex(index);
+    at(index) = std::move(value);
+}
+
+/*
+ * reserve(minCapacity): allocate the chunks for minCapacity items now
+ */
+template <class T>
+void SegmentedList<T>::reserve(int minCapacity)
+{
+    while (capacity < minCapacity)
+        addChunk();
+}
+
+//////////////////////////////////////////////////////////////////////
+//////////////////////// (private) METHOD DEFNITION //////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T>
+void SegmentedList<T>::checkIndex(int index)
+{
+    if (index < 0 || index >= count)
+        throw std::out_of_range("Index is out of range!");
+}
+
+/*
+ * addChunk(): the next chunk, twice as big as the last one
+ *      only the directory (pointers) may be re-allocated, never the items
+ */
+template <class T>
+void SegmentedList<T>::addChunk()
+{
+    if (nChunks + baseBits >= 31)
+        throw std::length_error("SegmentedList is full.");
+    if (nChunks == dirCapacity)
+    {
+        T **newChunks = new T *[dirCapacity * 2];
+        memcpy(newChunks, chunks, nChunks * sizeof(T *));
+        delete[] chunks;
+        chunks = newChunks;
+        dirCapacity *= 2;
+    }
+    int chunkSize = 1 << (baseBits + nChunks);
+    chunks[nChunks++] = new T[chunkSize];
+    capacity += chunkSize;
+}
+
+template <class T>
+void SegmentedList<T>::removeInternalData()
+{
+    if (deleteUserData != 0)
+        deleteUserData(this);
+    for (int k = 0; k < nChunks; k++)
+        delete[] chunks[k];
+    delete[] chunks;
+}
+
+template <class T>
+void SegmentedList<T>::copyFrom(const SegmentedList<T> &list)
+{
+    baseBits = list.baseBits;
+    dirCapacity = list.dirCapacity;
+    nChunks = list.nChunks;
+    capacity = list.capacity;
+    count = list.count;
+    itemEqual = list.itemEqual;
+    deleteUserData = nullptr;
+    chunks = new T *[dirCapacity];
+    for (int k = 0; k < nChunks; k++)
+    {
+        int chunkSize = 1 << (baseBits + k);
+        chunks[k] = new T[chunkSize];
+        for (int offset = 0; offset < chunkSize; offset++)
+            chunks[k][offset] = list.chunks[k][offset];
+    }
+}
+
+#endif /* SEGMENTEDLIST_H */
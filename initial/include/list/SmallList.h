@@ -0,0 +1,392 @@
+/*
+ * File:   SmallList.h
+ */
+
+#ifndef SMALLLIST_H
+#define SMALLLIST_H
+#include "list/IList.h"
+#include "util/MemLib.h"
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+using namespace std;
+/*
+ * SmallList<T, N>: an array list keeping its first N items inside the object
+ *  + up to N items: no allocation at all (children of a tree node,
+ *      attributes of a product, ...)
+ *  + more than N items: the items move to a heap array (capacity x2 when full),
+ *      then the list behaves as XArrayList
+ *  + the inline slots are constructed with the list (T must have T()),
+ *      as the slots of new T[] in XArrayList
+ *
+ * Example:
+ *  SmallList<Node*, 4> children;   // sizeof: 4 pointers + a few ints
+ *  children.add(left);             // no new
+ */
+template <class T, int N>
+class SmallList : public IList<T>
+{
+    static_assert(N > 0, "SmallList: N must be positive.");
+
+public:
+    class Iterator; // forward declaration
+
+protected:
+    T inlineItems[N];                           // the items while count <= N
+    T *heapItems;                               // the items after a spill (0: inline)
+    int capacity;                               // N, or size of heapItems
+    int count;                                  // number of items stored in the list
+    bool (*itemEqual)(T &lhs, T &rhs);          // function pointer: test if two items (type: T&) are equal or not
+    void (*deleteUserData)(SmallList<T, N> *);  // function pointer: be called to remove items (if they are pointer type)
+
+public:
+    SmallList(
+        void (*deleteUserData)(SmallList<T, N> *) = 0,
+        bool (*itemEqual)(T &, T &) = 0);
+    SmallList(const SmallList<T, N> &list);
+    SmallList<T, N> &operator=(const SmallList<T, N> &list);
+    ~SmallList();
+
+    // Inherit from IList: BEGIN
+    void add(T e);
+    void add(int index, T e);
+    T removeAt(int index);
+    bool removeItem(T item, void (*removeItemData)(T) = 0);
+    bool empty();
+    int size();
+    void clear();
+    T &get(int index);
+    int indexOf(T item);
+    bool contains(T item);
+    string toString(string (*item2str)(T &) = 0);
+    // Inherit from IList: END
+
+    void set(int index, T value);
+    int getCapacity()
+    {
+        return capacity;
+    }
+    /*
+     * isInline(): true while no heap array is used
+     */
+    bool isInline()
+    {
+        return heapItems == 0;
+    }
+
+    void println(string (*item2str)(T &) = 0)
+    {
+        cout << toString(item2str) << endl;
+    }
+
+    Iterator begin()
+    {
+        return Iterator(this, 0);
+    }
+    Iterator end()
+    {
+        return Iterator(this, count);
+    }
+
+    static void free(SmallList<T, N> *list)
+    {
+        T *items = list->items();
+        for (int idx = 0; idx < list->count; idx++)
+            delete items[idx];
+    }
+
+protected:
+    T *items()
+    {
+        return heapItems != 0 ? heapItems : inlineItems;
+    }
+    static bool equals(T &lhs, T &rhs, bool (*itemEqual)(T &, T &))
+    {
+        if (itemEqual == 0)
+            return lhs == rhs;
+        else
+            return itemEqual(lhs, rhs);
+    }
+    void checkIndex(int index);
+    void ensureCapacity(int index);
+    void copyFrom(const SmallList<T, N> &list);
+
+    //////////////////////////////////////////////////////////////////////
+    ////////////////////////  INNER CLASSES DEFNITION ////////////////////
+    //////////////////////////////////////////////////////////////////////
+public:
+    // Iterator: BEGIN
+    class Iterator
+    {
+    private:
+        int cursor;
+        SmallList<T, N> *pList;
+
+    public:
+        Iterator(SmallList<T, N> *pList = 0, int index = 0)
+        {
+            this->pList = pList;
+            this->cursor = index;
+        }
+        Iterator &operator=(const Iterator &iterator)
+        {
+            cursor = iterator.cursor;
+            pList = iterator.pList;
+            return *this;
+        }
+        void remove(void (*removeItemData)(T) = 0)
+        {
+            T item = pList->removeAt(cursor);
+            if (removeItemData != 0)
+                removeItemData(item);
+            cursor -= 1; // MUST keep index of previous, for ++ later
+        }
+
+        T &operator*()
+        {
+            return pList->items()[cursor];
+        }
+        bool operator!=(const Iterator &iterator)
+        {
+            return cursor != iterator.cursor;
+        }
+        // Prefix ++ overload
+        Iterator &operator++()
+        {
+            this->cursor++;
+            return *this;
+        }
+        // Postfix ++ overload
+        Iterator operator++(int)
+        {
+            Iterator iterator = *this;
+            ++*this;
+            return iterator;
+        }
+    };
+    // Iterator: END
+};
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////     METHOD DEFNITION      ///////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T, int N>
+SmallList<T, N>::SmallList(
+    void (*deleteUserData)(SmallList<T, N> *),
+    bool (*itemEqual)(T &, T &))
+{
+    this->heapItems = 0;
+    this->capacity = N;
+    this->count = 0;
+    this->itemEqual = itemEqual;
+    this->deleteUserData = deleteUserData;
+}
+
+template <class T, int N>
+SmallList<T, N>::SmallList(const SmallList<T, N> &list)
+{
+    copyFrom(list);
+    this->deleteUserData = list.deleteUserData;
+}
+
+template <class T, int N>
+SmallList<T, N> &SmallList<T, N>::operator=(const SmallList<T, N> &list)
+{
+    if (this == &list)
+        return *this;
+    if (deleteUserData != 0)
+        deleteUserData(this);
+    delete[] heapItems;
+    copyFrom(list);
+    return *this;
+}
+
+template <class T, int N>
+SmallList<T, N>::~SmallList()
+{
+    if (deleteUserData != 0)
+        deleteUserData(this);
+    delete[] heapItems;
+}
+
+template <class T, int N>
+void SmallList<T, N>::add(T e)
+{
+    ensureCapacity(count);
+    items()[count++] = std::move(e);
+}
+
+template <class T, int N>
+void SmallList<T, N>::add(int index, T e)
+{
+    if (index < 0 || index > count)
+        throw std::out_of_range("Index is out of range!");
+    ensureCapacity(count);
+    T *data = items();
+    shiftItems(data + index + 1, data + index, count - index);
+    data[index] = std::move(e);
+    count++;
+}
+
+template <class T, int N>
+T SmallList<T, N>::removeAt(int index)
+{
+    checkIndex(index);
+    T *data = items();
+    T result = std::move(data[index]);
+    shiftItems(data + index, data + index + 1, count - index - 1);
+    count--;
+    return result;
+}
+
+template <class T, int N>
+bool SmallList<T, N>::removeItem(T item, void (*removeItemData)(T))
+{
+    int index = indexOf(item);
+    if (index == -1)
+        return false;
+    if (removeItemData)
+        removeItemData(items()[index]);
+    removeAt(index);
+    return true;
+}
+
+template <class T, int N>
+bool SmallList<T, N>::empty()
+{
+    return count == 0;
+}
+
+template <class T, int N>
+int SmallList<T, N>::size()
+{
+    return count;
+}
+
+/*
+ * clear(): back to the inline slots
+ */
+template <class T, int N>
+void SmallList<T, N>::clear()
+{
+    if (deleteUserData != 0)
+        deleteUserData(this);
+    delete[] heapItems;
+    heapItems = 0;
+    for (int idx = 0; idx < N; idx++)
+        inlineItems[idx] = T();
+    capacity = N;
+    count = 0;
+}
+
+template <class T, int N>
+T &SmallList<T, N>::get(int index)
+{
+    checkIndex(index);
+    return items()[index];
+}
+
+template <class T, int N>
+int SmallList<T, N>::indexOf(T item)
+{
+    T *data = items();
+    for (int idx = 0; idx < count; idx++)
+        if (equals(data[idx], item, itemEqual))
+            return idx;
+    return -1;
+}
+
+template <class T, int N>
+bool SmallList<T, N>::contains(T item)
+{
+    return indexOf(item) != -1;
+}
+
+template <class T, int N>
+string SmallList<T, N>::toString(string (*item2str)(T &))
+{
+    T *data = items();
+    ostringstream ss;
+    ss << "[";
+    for (int idx = 0; idx < count; idx++)
+    {
+        if (idx > 0)
+            ss << ", ";
+        if (item2str)
+            ss << item2str(data[idx]);
+        else
+            ss << data[idx];
+    }
+    ss << "]";
+    return ss.str();
+}
+
+/*
+ * set(index, value): as SegmentedList::set, index == size() appends
+ */
+template <class T, int N>
+void SmallList<T, N>::set(int index, T value)
+{
+    if (index == count)
+    {
+        add(std::move(value));
+        return;
+    }
+    checkIndex(index);
+    items()[index] = std::move(value);
+}
+
+//////////////////////////////////////////////////////////////////////
+//////////////////////// (private) METHOD DEFNITION //////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class T, int N>
+void SmallList<T, N>::checkIndex(int index)
+{
+    if (index < 0 || index >= count)
+        throw std::out_of_range("Index is out of range!");
+}
+
+/*
+ * ensureCapacity(index): make slot index usable;
+ *      the first spill moves the inline items to the heap
+ */
+template <class T, int N>
+void SmallList<T, N>::ensureCapacity(int index)
+{
+    if (index < capacity)
+        return;
+    int newCapacity = capacity * 2;
+    while (newCapacity <= index)
+        newCapacity *= 2;
+    T *newItems = new T[newCapacity];
+    relocate(newItems, items(), count);
+    if (heapItems == 0)
+        for (int idx = 0; idx < count; idx++)
+            inlineItems[idx] = T(); // release the moved-from items now
+    delete[] heapItems;
+    heapItems = newItems;
+    capacity = newCapacity;
+}
+
+template <class T, int N>
+void SmallList<T, N>::copyFrom(const SmallList<T, N> &list)
+{
+    count = list.count;
+    itemEqual = list.itemEqual;
+    if (list.heapItems == 0)
+    {
+        heapItems = 0;
+        capacity = N;
+        copyItems(inlineItems, list.inlineItems, count);
+    }
+    else
+    {
+        capacity = list.capacity;
+        heapItems = new T[capacity];
+        copyItems(heapItems, list.heapItems, count);
+    }
+}
+
+#endif /* SMALLLIST_H */
@@ -5,10 +5,17 @@
  #ifndef XARRAYLIST_H
  #define XARRAYLIST_H
  #include "list/IList.h"
+ #include "util/MemLib.h"
+ #include "util/SimdLib.h"
  #include <memory.h>
  #include <sstream>
  #include <iostream>
  #include <type_traits>
+ #include <iterator>
+ #include <algorithm>
+ #include <utility>
+ #include <cstddef>
+ #include <stdexcept>
  using namespace std;
  
 
@@ -20,7 +27,10 @@ inline std::ostream& operator<<(std::ostream& os, const std::pair<char, int>& p)
  class XArrayList : public IList<T>
  {
  public:
-     class Iterator; // forward declaration
+     template <class Item>
+     class BasicIterator; // forward declaration
+     typedef BasicIterator<T> Iterator;
+     typedef BasicIterator<const T> ConstIterator;
  
  protected:
      T *data;                                 // dynamic array to store the list's items
@@ -28,12 +38,14 @@ inline std::ostream& operator<<(std::ostream& os, const std::pair<char, int>& p)
      int count;                               // number of items stored in the array
      bool (*itemEqual)(T &lhs, T &rhs);       // function pointer: test if two items (type: T&) are equal or not
      void (*deleteUserData)(XArrayList<T> *); // function pointer: be called to remove items (if they are pointer type)
+     pmr::memory_resource *resource;          // memory of the array (0: new[]/delete[]), see util/MemoryResource.h
  
  public:
      XArrayList(
          void (*deleteUserData)(XArrayList<T> *) = 0,
          bool (*itemEqual)(T &, T &) = 0,
-         int capacity = 10);
+         int capacity = 10,
+         pmr::memory_resource *resource = 0);
      XArrayList(const XArrayList<T> &list);
      XArrayList<T> &operator=(const XArrayList<T> &list);
      ~XArrayList();
@@ -61,6 +73,78 @@ inline std::ostream& operator<<(std::ostream& os, const std::pair<char, int>& p)
      {
          this->deleteUserData = deleteUserData;
      }
+
+     /** emplace:
+      * construct an item from args at the end of the list;
+      * add(T e) moves its argument, so add(std::move(x)) does not copy either
+      */
+     template <class... Args>
+     void emplace(Args &&...args)
+     {
+         ensureCapacity(count);
+         data[count++] = T(std::forward<Args>(args)...);
+     }
+     /** reserve:
+      * make room for minCapacity items with (at most) one re-allocation
+      */
+     void reserve(int minCapacity)
+     {
+         if (minCapacity > capacity)
+             reallocate(minCapacity);
+     }
+     int getCapacity()
+     {
+         return capacity;
+     }
+
+     /** bulk operations:
+      * each one grows the array at most once and shifts the tail once
+      * (memmove if T is trivially copyable), instead of one shift per item
+      *  + addAll(items, n): append n items copied from an array
+      *      (may be this list's own array, e.g. addAll(getData(), size()))
+      *  + insertRange(index, first, last): insert [first, last) before index
+      *      (any forward iterator or pointer, this list's items included:
+      *      the range is read before any item moves)
+      *  + removeRange(from, to): remove the items in [from, to)
+      *  + removeIf(predicate): remove all items with predicate(item) true,
+      *      keeping the order of the others; return the number removed
+      */
+     void addAll(const T *items, int n);
+     template <class InputIt>
+     void insertRange(int index, InputIt first, InputIt last);
+     void removeRange(int from, int to);
+     int removeIf(bool (*predicate)(T &), void (*removeItemData)(T) = 0);
+     /** adopt:
+      * take over an array created by new T[capacity] holding count items,
+      * instead of the current one (released as by clear); no item is copied;
+      * only for a list without memory resource
+      */
+     void adopt(T *array, int count, int capacity)
+     {
+         if (array == 0 || count < 0 || capacity < count || capacity <= 0 || resource != 0)
+             throw std::invalid_argument("Invalid array to adopt.");
+         if (deleteUserData)
+             deleteUserData(this);
+         delete[] data;
+         this->data = array;
+         this->count = count;
+         this->capacity = capacity;
+     }
+     /** getResource:
+      * memory resource of the array (0: new[]/delete[])
+      */
+     pmr::memory_resource *getResource()
+     {
+         return resource;
+     }
+     /** getData:
+      * pointer to the internal array: items [0, size()) are contiguous;
+      * valid until the next operation that re-allocates (add, reserve, clear)
+      */
+     T *getData()
+     {
+         return data;
+     }
  
      Iterator begin()
      {
@@ -70,6 +154,39 @@ inline std::ostream& operator<<(std::ostream& os, const std::pair<char, int>& p)
      {
          return Iterator(this, count);
      }
+     ConstIterator begin() const
+     {
+         return cbegin();
+     }
+     ConstIterator end() const
+     {
+         return cend();
+     }
+     ConstIterator cbegin() const
+     {
+         return ConstIterator(const_cast<XArrayList<T> *>(this), 0);
+     }
+     ConstIterator cend() const
+     {
+         return ConstIterator(const_cast<XArrayList<T> *>(this), count);
+     }
+
+     /** sort, stableSort:
+      * sort the items with comparator (same convention as Heap: negative if
+      * lhs comes first); no comparator: operator <
+      *  + sort: std::sort (introsort), stableSort: std::stable_sort (equal items keep their order)
+      *  + with an execution policy (include <execution>, link -ltbb for par with GCC):
+      *      list.sort(std::execution::par, comparator);
+      *      these overloads exist only for the types std::sort accepts as a policy
+      *      (list.sort(0) is the comparator overload); <execution> is not included
+      *      here: with GCC it requires -ltbb as soon as it is included
+      */
+     void sort(int (*comparator)(T &, T &) = 0);
+     void stableSort(int (*comparator)(T &, T &) = 0);
+     template <class ExecutionPolicy, class = decltype(std::sort(std::declval<ExecutionPolicy>(), (T *)0, (T *)0))>
+     void sort(ExecutionPolicy &&policy, int (*comparator)(T &, T &) = 0);
+     template <class ExecutionPolicy, class = decltype(std::stable_sort(std::declval<ExecutionPolicy>(), (T *)0, (T *)0))>
+     void stableSort(ExecutionPolicy &&policy, int (*comparator)(T &, T &) = 0);
  
      /** free:
       * if T is pointer type:
@@ -90,8 +207,16 @@ inline std::ostream& operator<<(std::ostream& os, const std::pair<char, int>& p)
      }
  
  protected:
-     void checkIndex(int index);     // check validity of index for accessing
-     void ensureCapacity(int index); // auto-allocate if needed
+     void checkIndex(int index);          // check validity of index for accessing
+     void ensureCapacity(int index);      // auto-allocate if needed (capacity x2)
+     void reallocate(int newCapacity);    // move items to a new array of newCapacity
+     int grownCapacity(int index)         // capacity x2 until index fits
+     {
+         int newCapacity = (capacity > 0) ? capacity * 2 : 1;
+         while (newCapacity <= index)
+             newCapacity *= 2;
+         return newCapacity;
+     }
  
      /** equals:
       * if T: primitive type:
@@ -127,53 +252,103 @@ inline std::ostream& operator<<(std::ostream& os, const std::pair<char, int>& p)
      //////////////////////////////////////////////////////////////////////
  public:
      // Iterator: BEGIN
-     class Iterator
+     /** BasicIterator:
+      * random-access iterator over the items, backed by a raw pointer:
+      *  + Iterator (T&) and ConstIterator (const T&); Iterator converts to ConstIterator
+      *  + std::iterator_traits, +, -, [], <, ...: usable with std::sort,
+      *      std::lower_bound, parallel algorithms, ...
+      *  + invalidated when the list re-allocates (add past capacity, reserve, clear)
+      *  + Iterator::remove(): remove the current item, the iterator then points
+      *      to the previous item (for ++ later)
+      */
+     template <class Item>
+     class BasicIterator
      {
+     public:
+         typedef std::random_access_iterator_tag iterator_category;
+         typedef typename std::remove_const<Item>::type value_type;
+         typedef std::ptrdiff_t difference_type;
+         typedef Item *pointer;
+         typedef Item &reference;
+
      private:
-         int cursor;
+         Item *ptr;
          XArrayList<T> *pList;
- 
+
      public:
-         Iterator(XArrayList<T> *pList = 0, int index = 0)
+         BasicIterator(XArrayList<T> *pList = 0, int index = 0)
          {
              this->pList = pList;
-             this->cursor = index;
+             this->ptr = pList != 0 ? pList->data + index : 0;
          }
-         Iterator &operator=(const Iterator &iterator)
+         // Iterator -> ConstIterator
+         template <class Other, class = typename std::enable_if<std::is_same<const Other, Item>::value &&
+                                                                !std::is_same<Other, Item>::value>::type>
+         BasicIterator(const BasicIterator<Other> &iterator)
          {
-             cursor = iterator.cursor;
-             pList = iterator.pList;
-             return *this;
+             this->pList = iterator.list();
+             this->ptr = iterator.base();
          }
+
          void remove(void (*removeItemData)(T) = 0)
          {
-             T item = pList->removeAt(cursor);
+             T item = pList->removeAt((int)(ptr - pList->data));
              if (removeItemData != 0)
                  removeItemData(item);
-             cursor -= 1; // MUST keep index of previous, for ++ later
+             ptr -= 1; // MUST keep index of previous, for ++ later
          }
- 
-         T &operator*()
+         Item *base() const { return ptr; }
+         XArrayList<T> *list() const { return pList; }
+
+         reference operator*() const { return *ptr; }
+         pointer operator->() const { return ptr; }
+         reference operator[](difference_type n) const { return ptr[n]; }
+
+         // Prefix ++ overload
+         BasicIterator &operator++()
          {
-             return pList->data[cursor];
+             ++ptr;
+             return *this;
          }
-         bool operator!=(const Iterator &iterator)
+         // Postfix ++ overload
+         BasicIterator operator++(int)
          {
-             return cursor != iterator.cursor;
+             BasicIterator iterator = *this;
+             ++ptr;
+             return iterator;
          }
-         // Prefix ++ overload
-         Iterator &operator++()
+         BasicIterator &operator--()
          {
-             this->cursor++;
+             --ptr;
              return *this;
          }
-         // Postfix ++ overload
-         Iterator operator++(int)
+         BasicIterator operator--(int)
          {
-             Iterator iterator = *this;
-             ++*this;
+             BasicIterator iterator = *this;
+             --ptr;
              return iterator;
          }
+         BasicIterator &operator+=(difference_type n)
+         {
+             ptr += n;
+             return *this;
+         }
+         BasicIterator &operator-=(difference_type n)
+         {
+             ptr -= n;
+             return *this;
+         }
+         friend BasicIterator operator+(BasicIterator it, difference_type n) { return it += n; }
+         friend BasicIterator operator+(difference_type n, BasicIterator it) { return it += n; }
+         friend BasicIterator operator-(BasicIterator it, difference_type n) { return it -= n; }
+         friend difference_type operator-(const BasicIterator &lhs, const BasicIterator &rhs) { return lhs.ptr - rhs.ptr; }
+
+         friend bool operator==(const BasicIterator &lhs, const BasicIterator &rhs) { return lhs.ptr == rhs.ptr; }
+         friend bool operator!=(const BasicIterator &lhs, const BasicIterator &rhs) { return lhs.ptr != rhs.ptr; }
+         friend bool operator<(const BasicIterator &lhs, const BasicIterator &rhs) { return lhs.ptr < rhs.ptr; }
+         friend bool operator>(const BasicIterator &lhs, const BasicIterator &rhs) { return lhs.ptr > rhs.ptr; }
+         friend bool operator<=(const BasicIterator &lhs, const BasicIterator &rhs) { return lhs.ptr <= rhs.ptr; }
+         friend bool operator>=(const BasicIterator &lhs, const BasicIterator &rhs) { return lhs.ptr >= rhs.ptr; }
      };
      // Iterator: END
  };
@@ -186,14 +361,16 @@ inline std::ostream& operator<<(std::ostream& os, const std::pair<char, int>& p)
  XArrayList<T>::XArrayList(
      void (*deleteUserData)(XArrayList<T> *),
      bool (*itemEqual)(T &, T &),
-     int capacity)
+     int capacity,
+     pmr::memory_resource *resource)
  {
      // TODO
+     capacity=capacity > 0 ? capacity : 10;
      this->capacity=capacity;
      this->deleteUserData=deleteUserData ? deleteUserData : NULL;
      this->itemEqual=itemEqual?itemEqual : NULL ; 
-     capacity=capacity > 0 ? capacity : 10;
-     this->data= new T[capacity];
+     this->resource = resource;
+     this->data= newArray<T>(resource, capacity);
      this->count=0; 
  }
  
@@ -212,6 +389,7 @@ inline std::ostream& operator<<(std::ostream& os, const std::pair<char, int>& p)
     this->count = list.count;
     this->itemEqual = list.itemEqual;
     this->deleteUserData = list.deleteUserData;
+    this->resource = 0;
 
     this->data = new T[this->capacity];
     for (int i = 0; i < this->count; i++) {
@@ -238,6 +416,7 @@ inline std::ostream& operator<<(std::ostream& os, const std::pair<char, int>& p)
      // TODO
      this->capacity =  list.capacity;
      this->count = list.count;
+     this->resource = 0; // as std::pmr containers: a copy does not take the resource
      this->data = new T[capacity];
      for(int i = 0; i< count; i++){
          this->data[i] = list.data[i];
@@ -255,12 +434,12 @@ XArrayList<T> &XArrayList<T>::operator=(const XArrayList<T> &list)
         deleteUserData(this);
     }
     if (data) {
-        delete[] data;
+        deleteArray(resource, data, capacity);
     }
 
     this->capacity = list.capacity;
     this->count = list.count;
-    this->data = new T[capacity];
+    this->data = newArray<T>(resource, capacity);
     for (int i = 0; i < count; i++) {
         this->data[i] = list.data[i];
     }
@@ -276,7 +455,7 @@ XArrayList<T> &XArrayList<T>::operator=(const XArrayList<T> &list)
      if(deleteUserData){
          deleteUserData(this);
      }
-    delete[] data;
+    deleteArray(resource, data, capacity);
      this->count = 0;
      this->capacity =  0;
  }
@@ -285,10 +464,8 @@ XArrayList<T> &XArrayList<T>::operator=(const XArrayList<T> &list)
  void XArrayList<T>::add(T e)
  {
      // TODO
-     if(count == capacity){
-        ensureCapacity(capacity +1);
-     }
-     data[count++] = e;
+     ensureCapacity(count);
+     data[count++] = std::move(e);
  }
  
  template <class T>
@@ -300,10 +477,8 @@ XArrayList<T> &XArrayList<T>::operator=(const XArrayList<T> &list)
          throw std:: out_of_range("Index is out of range!");
      }
      else{
-     for(int i =  count-1; i>=index; i--){
-         data[i+1] =  data[i];
-     }
-         data[index] = e;
+         shiftItems(data + index + 1, data + index, count - index);
+         data[index] = std::move(e);
          count++;
  }
 }
@@ -313,10 +488,8 @@ XArrayList<T> &XArrayList<T>::operator=(const XArrayList<T> &list)
      // TODO
      if(index<0 || index >= count)
          throw std::out_of_range("Index is out of range!");
-     T result =  data[index];
-     for(int i=index; i< count-1; i++){
-         data[i]= data[i+1];
-     }
+     T result =  std::move(data[index]);
+     shiftItems(data + index, data + index + 1, count - index - 1);
      count --;
      return result;
  
@@ -376,11 +549,11 @@ XArrayList<T> &XArrayList<T>::operator=(const XArrayList<T> &list)
          deleteUserData(this);
      }
      if(data){
-     delete[] data; 
+     deleteArray(resource, data, capacity);
      count = 0;
      }
      capacity=10;
-     data= new T[capacity];
+     data= newArray<T>(resource, capacity);
      count=0;
 }
  template <class T>
@@ -397,6 +570,10 @@ XArrayList<T> &XArrayList<T>::operator=(const XArrayList<T> &list)
  int XArrayList<T>::indexOf(T item)
  {
      // TODO
+     // numbers compared with ==: vectorized search (see util/SimdLib.h)
+     if constexpr (hasSimdSearch<T>::value)
+         if (itemEqual == 0)
+             return simdIndexOf(data, count, item);
      for (int i = 0; i < count; ++i)
      {
          if (equals(data[i], item, itemEqual))
@@ -450,6 +627,132 @@ XArrayList<T> &XArrayList<T>::operator=(const XArrayList<T> &list)
      
  }
  
+ template <class T>
+ void XArrayList<T>::addAll(const T *items, int n)
+ {
+     if (n < 0)
+         throw std::invalid_argument("Number of items must be non-negative.");
+     if (n == 0)
+         return;
+     if (items >= data && items < data + capacity)
+     {
+         // items inside this list: find them again in the new array
+         int offset = (int)(items - data);
+         ensureCapacity(count + n - 1);
+         items = data + offset;
+     }
+     else
+         ensureCapacity(count + n - 1);
+     copyItems(data + count, items, n);
+     count += n;
+ }
+
+ template <class T>
+ template <class InputIt>
+ void XArrayList<T>::insertRange(int index, InputIt first, InputIt last)
+ {
+     if (index < 0 || index > count)
+         throw std::out_of_range("Index is out of range!");
+     int n = (int)std::distance(first, last);
+     if (n <= 0)
+         return;
+     if (count + n > capacity)
+     {
+         // new array: copy the range first, the old array is still intact
+         int newCapacity = grownCapacity(count + n - 1);
+         T *newData = newArray<T>(resource, newCapacity);
+         for (int i = index; first != last; ++first, ++i)
+             newData[i] = *first;
+         relocate(newData, data, index);
+         relocate(newData + index + n, data + index, count - index);
+         deleteArray(resource, data, capacity);
+         data = newData;
+         capacity = newCapacity;
+     }
+     else
+     {
+         // append after the last item (nothing moves while the range is read),
+         // then rotate the new items into place
+         for (int i = count; first != last; ++first, ++i)
+             data[i] = *first;
+         std::rotate(data + index, data + count, data + count + n);
+     }
+     count += n;
+ }
+
+ template <class T>
+ void XArrayList<T>::removeRange(int from, int to)
+ {
+     if (from < 0 || to > count || from > to)
+         throw std::out_of_range("Index is out of range!");
+     shiftItems(data + from, data + to, count - to);
+     count -= to - from;
+ }
+
+ template <class T>
+ int XArrayList<T>::removeIf(bool (*predicate)(T &), void (*removeItemData)(T))
+ {
+     // one pass: the kept items move down over the removed ones
+     int kept = 0;
+     for (int i = 0; i < count; i++)
+     {
+         if (predicate(data[i]))
+         {
+             if (removeItemData)
+                 removeItemData(data[i]);
+             continue;
+         }
+         if (kept != i)
+             data[kept] = std::move(data[i]);
+         kept++;
+     }
+     int removed = count - kept;
+     count = kept;
+     return removed;
+ }
+
+ /*
+  * XArrayListLess: the comparator of sort as the "less" predicate of <algorithm>
+  *      (comparator takes T&: the algorithms never modify the items they compare)
+  */
+ template <class T>
+ struct XArrayListLess
+ {
+     int (*comparator)(T &, T &);
+     bool operator()(const T &lhs, const T &rhs) const
+     {
+         if (comparator != 0)
+             return comparator(const_cast<T &>(lhs), const_cast<T &>(rhs)) < 0;
+         return lhs < rhs;
+     }
+ };
+
+ template <class T>
+ void XArrayList<T>::sort(int (*comparator)(T &, T &))
+ {
+     std::sort(data, data + count, XArrayListLess<T>{comparator});
+ }
+
+ template <class T>
+ void XArrayList<T>::stableSort(int (*comparator)(T &, T &))
+ {
+     std::stable_sort(data, data + count, XArrayListLess<T>{comparator});
+ }
+
+ template <class T>
+ template <class ExecutionPolicy, class>
+ void XArrayList<T>::sort(ExecutionPolicy &&policy, int (*comparator)(T &, T &))
+ {
+     std::sort(std::forward<ExecutionPolicy>(policy), begin(), end(), XArrayListLess<T>{comparator});
+ }
+
+ template <class T>
+ template <class ExecutionPolicy, class>
+ void XArrayList<T>::stableSort(ExecutionPolicy &&policy, int (*comparator)(T &, T &))
+ {
+     std::stable_sort(std::forward<ExecutionPolicy>(policy), begin(), end(), XArrayListLess<T>{comparator});
+ }
+
  //////////////////////////////////////////////////////////////////////
  //////////////////////// (private) METHOD DEFNITION //////////////////
  //////////////////////////////////////////////////////////////////////
@@ -473,22 +776,7 @@ try{
      }
  
      if (index >= capacity) {
-         int newCapacity = (capacity > 0) ? capacity * 2 : 1;
- 
-         while (newCapacity <= index) {
-             newCapacity *= 2;
-         }
- 
-         T* newData = new T[newCapacity];
- 
-         for (int i = 0; i < count; i++) {
-             newData[i] = data[i];
-         }
- 
-         delete[] data;
- 
-         data = newData;
-         capacity = newCapacity;
+         reallocate(grownCapacity(index));
      }
  }
     catch(const std:: bad_alloc &k){
@@ -496,6 +784,15 @@ try{
 }
 
 
+ }
+ template <class T>
+ void XArrayList<T>::reallocate(int newCapacity)
+ {
+     T* newData = newArray<T>(resource, newCapacity);
+     relocate(newData, data, count);
+     deleteArray(resource, data, capacity);
+     data = newData;
+     capacity = newCapacity;
  }
 
  #endif /* XARRAYLIST_H */
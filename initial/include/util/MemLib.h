@@ -0,0 +1,130 @@
+#ifndef MEMLIB_H
+#define MEMLIB_H
+
+#include <memory.h>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+using namespace std;
+
+/*
+ * Helpers for containers storing their items in arrays created by new T[]:
+ *      all slots of both arrays are already constructed,
+ *      so items are moved by assignment.
+ *
+ * relocate(dst, src, n): move n items from src to dst (non-overlapping)
+ *  + T trivially copyable (int, double, pointers, ...): one memcpy
+ *  + otherwise (string, pair<string,int>, ...): move-assign item by item,
+ *      i.e., no deep copy and no bitwise copy of non-trivial objects
+ */
+template <class T>
+inline void relocate(T *dst, T *src, int n)
+{
+    if (n <= 0)
+        return;
+    if constexpr (is_trivially_copyable<T>::value)
+        memcpy(dst, src, n * sizeof(T));
+    else
+        for (int idx = 0; idx < n; idx++)
+            dst[idx] = std::move(src[idx]);
+}
+
+/*
+ * shiftItems(dst, src, n): move n items inside one array (ranges may overlap)
+ *  + T trivially copyable: one memmove
+ *  + otherwise: move-assign in the direction that does not overwrite
+ *      an item before it is moved
+ */
+template <class T>
+inline void shiftItems(T *dst, T *src, int n)
+{
+    if (n <= 0 || dst == src)
+        return;
+    if constexpr (is_trivially_copyable<T>::value)
+        memmove(dst, src, n * sizeof(T));
+    else if (dst < src)
+        for (int idx = 0; idx < n; idx++)
+            dst[idx] = std::move(src[idx]);
+    else
+        for (int idx = n - 1; idx >= 0; idx--)
+            dst[idx] = std::move(src[idx]);
+}
+
+/*
+ * copyItems(dst, src, n): copy n items (non-overlapping), src is kept
+ */
+template <class T>
+inline void copyItems(T *dst, const T *src, int n)
+{
+    if (n <= 0)
+        return;
+    if constexpr (is_trivially_copyable<T>::value)
+        memcpy(dst, src, n * sizeof(T));
+    else
+        for (int idx = 0; idx < n; idx++)
+            dst[idx] = src[idx];
+}
+
+/*
+ * Allocation helpers for containers with an optional memory resource
+ *      (std::pmr::memory_resource*, see util/MemoryResource.h):
+ *      resource == 0 keeps the default behavior, new / new[] and delete / delete[]
+ *
+ * newArray<T>(resource, n, args...): n constructed items
+ *  + no resource: new T[n] (args are not used: T())
+ *  + resource: memory from the resource, each item built by T(args...),
+ *      e.g. the resource itself for the buckets of a hash table
+ * deleteArray(resource, array, n): release an array of newArray(resource, n)
+ * newObject<T>(resource, args...), deleteObject(resource, object): one object
+ */
+template <class T, class... Args>
+inline T *newArray(pmr::memory_resource *resource, int n, const Args &...args)
+{
+    if (resource == 0)
+        return new T[n];
+    T *array = static_cast<T *>(resource->allocate(n * sizeof(T), alignof(T)));
+    for (int idx = 0; idx < n; idx++)
+        ::new (static_cast<void *>(array + idx)) T(args...);
+    return array;
+}
+
+template <class T>
+inline void deleteArray(pmr::memory_resource *resource, T *array, int n)
+{
+    if (resource == 0)
+    {
+        delete[] array;
+        return;
+    }
+    if (array == 0)
+        return;
+    for (int idx = 0; idx < n; idx++)
+        array[idx].~T();
+    resource->deallocate(array, n * sizeof(T), alignof(T));
+}
+
+template <class T, class... Args>
+inline T *newObject(pmr::memory_resource *resource, Args &&...args)
+{
+    if (resource == 0)
+        return new T(std::forward<Args>(args)...);
+    void *memory = resource->allocate(sizeof(T), alignof(T));
+    return ::new (memory) T(std::forward<Args>(args)...);
+}
+
+template <class T>
+inline void deleteObject(pmr::memory_resource *resource, T *object)
+{
+    if (resource == 0)
+    {
+        delete object;
+        return;
+    }
+    if (object == 0)
+        return;
+    object->~T();
+    resource->deallocate(object, sizeof(T), alignof(T));
+}
+
+#endif /* MEMLIB_H */
@@ -0,0 +1,209 @@
+#ifndef SIMDLIB_H
+#define SIMDLIB_H
+
+#include <type_traits>
+#include <cstdint>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SIMDLIB_SSE2 1
+#endif
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+using namespace std;
+
+/*
+ * Vectorized linear search in arrays of numbers
+ *
+ * simdIndexOf(data, n, value): index of the first item == value, -1 if none
+ *  + T: arithmetic type except bool (char, short, int, long long,
+ *      float, double, signed or unsigned): see hasSimdSearch<T>
+ *  + compares 16 bytes (SSE2, always on x86-64) or 32 bytes (AVX2, when
+ *      compiled with -mavx2 / -march=native) of items at once,
+ *      then finds the first match in the movemask of the compare
+ *  + float/double use the floating-point compare: same result as ==
+ *      (NaN never found, 0.0 == -0.0)
+ *  + without SSE2 (not x86): scalarIndexOf
+ */
+template <class T>
+struct hasSimdSearch
+{
+    static const bool value = is_arithmetic<T>::value && !is_same<T, bool>::value &&
+                              (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+};
+
+template <class T>
+inline int scalarIndexOf(const T *data, int n, T value)
+{
+    for (int idx = 0; idx < n; idx++)
+        if (data[idx] == value)
+            return idx;
+    return -1;
+}
+
+#ifdef SIMDLIB_SSE2
+namespace simdlib
+{
+    inline int firstBit(unsigned int mask)
+    {
+#if defined(__GNUC__)
+        return __builtin_ctz(mask);
+#else
+        int bit = 0;
+        while ((mask & 1) == 0)
+        {
+            mask >>= 1;
+            bit++;
+        }
+        return bit;
+#endif
+    }
+
+    /*
+     * Lanes<T>: broadcast a value, compare a vector of items with it;
+     *      a matching item gives sizeof(T) set bits in the byte movemask
+     */
+    template <class T, bool isFloat = is_floating_point<T>::value, int size = sizeof(T)>
+    struct Lanes;
+
+    template <class T>
+    struct Lanes<T, false, 1>
+    {
+        static __m128i splat(T value) { return _mm_set1_epi8((char)value); }
+        static __m128i equal(const T *p, __m128i key) { return _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)p), key); }
+#ifdef __AVX2__
+        static __m256i splat256(T value) { return _mm256_set1_epi8((char)value); }
+        static __m256i equal(const T *p, __m256i key) { return _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)p), key); }
+#endif
+    };
+
+    template <class T>
+    struct Lanes<T, false, 2>
+    {
+        static __m128i splat(T value) { return _mm_set1_epi16((short)value); }
+        static __m128i equal(const T *p, __m128i key) { return _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i *)p), key); }
+#ifdef __AVX2__
+        static __m256i splat256(T value) { return _mm256_set1_epi16((short)value); }
+        static __m256i equal(const T *p, __m256i key) { return _mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i *)p), key); }
+#endif
+    };
+
+    template <class T>
+    struct Lanes<T, false, 4>
+    {
+        static __m128i splat(T value) { return _mm_set1_epi32((int)value); }
+        static __m128i equal(const T *p, __m128i key) { return _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)p), key); }
+#ifdef __AVX2__
+        static __m256i splat256(T value) { return _mm256_set1_epi32((int)value); }
+        static __m256i equal(const T *p, __m256i key) { return _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)p), key); }
+#endif
+    };
+
+    template <class T>
+    struct Lanes<T, false, 8>
+    {
+        static __m128i splat(T value) { return _mm_set1_epi64x((long long)value); }
+        static __m128i equal(const T *p, __m128i key)
+        {
+            __m128i items = _mm_loadu_si128((const __m128i *)p);
+#ifdef __SSE4_1__
+            return _mm_cmpeq_epi64(items, key);
+#else
+            // SSE2: both 32-bit halves equal
+            __m128i halves = _mm_cmpeq_epi32(items, key);
+            return _mm_and_si128(halves, _mm_shuffle_epi32(halves, 0xB1));
+#endif
+        }
+#ifdef __AVX2__
+        static __m256i splat256(T value) { return _mm256_set1_epi64x((long long)value); }
+        static __m256i equal(const T *p, __m256i key) { return _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *)p), key); }
+#endif
+    };
+
+    template <class T>
+    struct Lanes<T, true, 4>
+    {
+        static __m128i splat(T value) { return _mm_castps_si128(_mm_set1_ps(value)); }
+        static __m128i equal(const T *p, __m128i key)
+        {
+            return _mm_castps_si128(_mm_cmpeq_ps(_mm_loadu_ps((const float *)p), _mm_castsi128_ps(key)));
+        }
+#ifdef __AVX2__
+        static __m256i splat256(T value) { return _mm256_castps_si256(_mm256_set1_ps(value)); }
+        static __m256i equal(const T *p, __m256i key)
+        {
+            return _mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps((const float *)p), _mm256_castsi256_ps(key), _CMP_EQ_OQ));
+        }
+#endif
+    };
+
+    template <class T>
+    struct Lanes<T, true, 8>
+    {
+        static __m128i splat(T value) { return _mm_castpd_si128(_mm_set1_pd(value)); }
+        static __m128i equal(const T *p, __m128i key)
+        {
+            return _mm_castpd_si128(_mm_cmpeq_pd(_mm_loadu_pd((const double *)p), _mm_castsi128_pd(key)));
+        }
+#ifdef __AVX2__
+        static __m256i splat256(T value) { return _mm256_castpd_si256(_mm256_set1_pd(value)); }
+        static __m256i equal(const T *p, __m256i key)
+        {
+            return _mm256_castpd_si256(_mm256_cmp_pd(_mm256_loadu_pd((const double *)p), _mm256_castsi256_pd(key), _CMP_EQ_OQ));
+        }
+#endif
+    };
+}
+#endif
+
+template <class T>
+inline int simdIndexOf(const T *data, int n, T value)
+{
+    static_assert(hasSimdSearch<T>::value, "simdIndexOf: T must be a number type.");
+#ifdef SIMDLIB_SSE2
+    typedef simdlib::Lanes<T> L;
+    int idx = 0;
+#ifdef __AVX2__
+    const int PER_VECTOR = 32 / sizeof(T);
+    __m256i key = L::splat256(value);
+    // two vectors per step: one test for both
+    for (; idx + 2 * PER_VECTOR <= n; idx += 2 * PER_VECTOR)
+    {
+        __m256i first = L::equal(data + idx, key);
+        __m256i second = L::equal(data + idx + PER_VECTOR, key);
+        if (_mm256_testz_si256(_mm256_or_si256(first, second), _mm256_or_si256(first, second)))
+            continue;
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(first);
+        if (mask != 0)
+            return idx + simdlib::firstBit(mask) / (int)sizeof(T);
+        mask = (unsigned int)_mm256_movemask_epi8(second);
+        return idx + PER_VECTOR + simdlib::firstBit(mask) / (int)sizeof(T);
+    }
+#else
+    const int PER_VECTOR = 16 / sizeof(T);
+    __m128i key = L::splat(value);
+    for (; idx + 2 * PER_VECTOR <= n; idx += 2 * PER_VECTOR)
+    {
+        __m128i first = L::equal(data + idx, key);
+        __m128i second = L::equal(data + idx + PER_VECTOR, key);
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_or_si128(first, second));
+        if (mask == 0)
+            continue;
+        mask = (unsigned int)_mm_movemask_epi8(first);
+        if (mask != 0)
+            return idx + simdlib::firstBit(mask) / (int)sizeof(T);
+        mask = (unsigned int)_mm_movemask_epi8(second);
+        return idx + PER_VECTOR + simdlib::firstBit(mask) / (int)sizeof(T);
+    }
+#endif
+    int found = scalarIndexOf(data + idx, n - idx, value);
+    return found == -1 ? -1 : idx + found;
+#else
+    return scalarIndexOf(data, n, value);
+#endif
+}
+
+#endif /* SIMDLIB_H */
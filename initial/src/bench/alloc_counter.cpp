@@ -0,0 +1,184 @@
+#include "bench/alloc_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/*
+ * Each block starts with a header holding its size: operator delete
+ * (plain or sized) knows how many bytes are released.
+ * HEADER keeps the alignment of malloc (16 bytes on x86-64).
+ */
+static const size_t HEADER = 16;
+
+static std::atomic<long long> nAllocations(0);
+static std::atomic<long long> nLiveBytes(0);
+static std::atomic<long long> nPeakBytes(0);
+
+static void *countedAlloc(size_t size)
+{
+    char *block = (char *)std::malloc(size + HEADER);
+    if (block == 0)
+        return 0;
+    *(size_t *)block = size;
+    nAllocations.fetch_add(1, std::memory_order_relaxed);
+    long long live = nLiveBytes.fetch_add((long long)size, std::memory_order_relaxed) + (long long)size;
+    long long peak = nPeakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !nPeakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        ;
+    return block + HEADER;
+}
+
+static void countedFree(void *ptr)
+{
+    if (ptr == 0)
+        return;
+    char *block = (char *)ptr - HEADER;
+    nLiveBytes.fetch_sub((long long)*(size_t *)block, std::memory_order_relaxed);
+    std::free(block);
+}
+
+/*
+ * Over-aligned blocks (operator new with std::align_val_t, e.g. from
+ * std::pmr::new_delete_resource): one counted block with room to align,
+ * the start of that block is kept just before the aligned pointer.
+ */
+static void *countedAlignedAlloc(size_t size, std::align_val_t alignment)
+{
+    size_t align = (size_t)alignment;
+    if (align <= HEADER)
+        return countedAlloc(size);
+    char *block = (char *)countedAlloc(size + align + sizeof(void *));
+    if (block == 0)
+        return 0;
+    size_t aligned = ((size_t)(block + sizeof(void *)) + align - 1) & ~(align - 1);
+    ((void **)aligned)[-1] = block;
+    return (void *)aligned;
+}
+
+static void countedAlignedFree(void *ptr, std::align_val_t alignment)
+{
+    if (ptr == 0)
+        return;
+    if ((size_t)alignment <= HEADER)
+        countedFree(ptr);
+    else
+        countedFree(((void **)ptr)[-1]);
+}
+
+long long AllocCounter::allocations()
+{
+    return nAllocations.load();
+}
+
+long long AllocCounter::liveBytes()
+{
+    return nLiveBytes.load();
+}
+
+long long AllocCounter::peakBytes()
+{
+    return nPeakBytes.load();
+}
+
+void AllocCounter::reset()
+{
+    nAllocations.store(0);
+    nPeakBytes.store(nLiveBytes.load());
+}
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  GLOBAL OPERATOR NEW/DELETE  ////////////////
+//////////////////////////////////////////////////////////////////////
+
+void *operator new(size_t size)
+{
+    void *ptr = countedAlloc(size);
+    if (ptr == 0)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void *operator new[](size_t size)
+{
+    void *ptr = countedAlloc(size);
+    if (ptr == 0)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    return countedAlloc(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    return countedAlloc(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    countedFree(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    countedFree(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    countedFree(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept
+{
+    countedFree(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept
+{
+    countedFree(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept
+{
+    countedFree(ptr);
+}
+
+void *operator new(size_t size, std::align_val_t alignment)
+{
+    void *ptr = countedAlignedAlloc(size, alignment);
+    if (ptr == 0)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void *operator new[](size_t size, std::align_val_t alignment)
+{
+    void *ptr = countedAlignedAlloc(size, alignment);
+    if (ptr == 0)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void *ptr, std::align_val_t alignment) noexcept
+{
+    countedAlignedFree(ptr, alignment);
+}
+
+void operator delete[](void *ptr, std::align_val_t alignment) noexcept
+{
+    countedAlignedFree(ptr, alignment);
+}
+
+void operator delete(void *ptr, size_t, std::align_val_t alignment) noexcept
+{
+    countedAlignedFree(ptr, alignment);
+}
+
+void operator delete[](void *ptr, size_t, std::align_val_t alignment) noexcept
+{
+    countedAlignedFree(ptr, alignment);
+}
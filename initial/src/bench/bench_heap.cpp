@@ -0,0 +1,964 @@
+#include "bench/bench_heap.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <thread>
+#include "bench/bench_util.h"
+#include "bench/perf_counters.h"
+#include "heap/Heap.h"
+#include "heap/IndexedHeap.h"
+#include "heap/TopK.h"
+#include "heap/KWayMerger.h"
+#include "heap/MultiQueue.h"
+#include "heap/RadixHeap.h"
+#include "heap/PairingHeap.h"
+#include "heap/BlockHeap.h"
+#include "heap/ExternalHeap.h"
+#include "heap/TimerScheduler.h"
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  SHORTEST-PATH WORKLOAD  ////////////////////
+//////////////////////////////////////////////////////////////////////
+
+/*
+ * Graph: random directed graph in CSR form
+ *      edges of vertex v: target[first[v] .. first[v+1]-1]
+ */
+struct Graph
+{
+    int nVertices;
+    int nEdges;
+    int *first;
+    int *target;
+    int *weight;
+
+    Graph(int nVertices, int degree, int maxWeight, int seed)
+    {
+        this->nVertices = nVertices;
+        this->nEdges = nVertices * degree;
+        first = new int[nVertices + 1];
+        target = new int[nEdges];
+        weight = new int[nEdges];
+
+        mt19937 engine(seed);
+        uniform_int_distribution<int> vertexDist(0, nVertices - 1);
+        uniform_int_distribution<int> weightDist(1, maxWeight);
+        for (int v = 0; v < nVertices; v++)
+        {
+            first[v] = v * degree;
+            // edge (v -> v+1) keeps every vertex reachable from 0
+            target[first[v]] = (v + 1) % nVertices;
+            weight[first[v]] = weightDist(engine);
+            for (int e = 1; e < degree; e++)
+            {
+                target[first[v] + e] = vertexDist(engine);
+                weight[first[v] + e] = weightDist(engine);
+            }
+        }
+        first[nVertices] = nEdges;
+    }
+    ~Graph()
+    {
+        delete[] first;
+        delete[] target;
+        delete[] weight;
+    }
+};
+
+struct DistEntry
+{
+    long long dist;
+    int vertex;
+
+    bool operator<(const DistEntry &other) const { return dist < other.dist; }
+    bool operator>(const DistEntry &other) const { return dist > other.dist; }
+    friend ostream &operator<<(ostream &os, const DistEntry &entry)
+    {
+        os << "(" << entry.vertex << ", " << entry.dist << ")";
+        return os;
+    }
+};
+
+inline int distEntryComparator(DistEntry &lhs, DistEntry &rhs)
+{
+    if (lhs.dist < rhs.dist)
+        return -1;
+    else if (lhs.dist > rhs.dist)
+        return +1;
+    else
+        return 0;
+}
+
+inline int distComparator(long long &lhs, long long &rhs)
+{
+    if (lhs < rhs)
+        return -1;
+    else if (lhs > rhs)
+        return +1;
+    else
+        return 0;
+}
+
+static const long long INF_DIST = 1LL << 62;
+
+/*
+ * dijkstraHeap: Heap<T> has no decrease-key,
+ *      so a vertex is pushed again on every relaxation (lazy deletion)
+ */
+static long long dijkstraHeap(Graph &graph, long long *dist, long long &heapOps)
+{
+    for (int v = 0; v < graph.nVertices; v++)
+        dist[v] = INF_DIST;
+    Heap<DistEntry> heap(&distEntryComparator);
+    dist[0] = 0;
+    heap.push(DistEntry{0, 0});
+    heapOps = 1;
+    while (!heap.empty())
+    {
+        DistEntry entry = heap.pop();
+        heapOps++;
+        if (entry.dist > dist[entry.vertex])
+            continue; // stale entry
+        for (int e = graph.first[entry.vertex]; e < graph.first[entry.vertex + 1]; e++)
+        {
+            long long candidate = entry.dist + graph.weight[e];
+            int next = graph.target[e];
+            if (candidate < dist[next])
+            {
+                dist[next] = candidate;
+                heap.push(DistEntry{candidate, next});
+                heapOps++;
+            }
+        }
+    }
+    long long checksum = 0;
+    for (int v = 0; v < graph.nVertices; v++)
+        checksum += dist[v];
+    return checksum;
+}
+
+/*
+ * dijkstraIndexedHeap: one entry per vertex, relaxations use decrease-key
+ */
+static long long dijkstraIndexedHeap(Graph &graph, long long *dist, long long &heapOps)
+{
+    for (int v = 0; v < graph.nVertices; v++)
+        dist[v] = INF_DIST;
+    IndexedHeap<long long> heap(&distComparator, graph.nVertices);
+    dist[0] = 0;
+    heap.push(0, 0);
+    heapOps = 1;
+    while (!heap.empty())
+    {
+        int vertex = heap.peekKey();
+        heap.popKey();
+        heapOps++;
+        for (int e = graph.first[vertex]; e < graph.first[vertex + 1]; e++)
+        {
+            long long candidate = dist[vertex] + graph.weight[e];
+            int next = graph.target[e];
+            if (candidate < dist[next])
+            {
+                bool queued = heap.contains(next);
+                dist[next] = candidate;
+                if (queued)
+                    heap.update(next, candidate);
+                else
+                    heap.push(next, candidate);
+                heapOps++;
+            }
+        }
+    }
+    long long checksum = 0;
+    for (int v = 0; v < graph.nVertices; v++)
+        checksum += dist[v];
+    return checksum;
+}
+
+/*
+ * dijkstraRadixHeap: lazy re-push as dijkstraHeap,
+ *      the distances popped are non-decreasing: a radix heap applies
+ */
+static long long dijkstraRadixHeap(Graph &graph, long long *dist, long long &heapOps)
+{
+    for (int v = 0; v < graph.nVertices; v++)
+        dist[v] = INF_DIST;
+    RadixHeap<unsigned long long, int> heap;
+    dist[0] = 0;
+    heap.push(0, 0);
+    heapOps = 1;
+    while (!heap.empty())
+    {
+        long long vertexDist = (long long)heap.peekKey();
+        int vertex = heap.pop();
+        heapOps++;
+        if (vertexDist > dist[vertex])
+            continue; // stale entry
+        for (int e = graph.first[vertex]; e < graph.first[vertex + 1]; e++)
+        {
+            long long candidate = vertexDist + graph.weight[e];
+            int next = graph.target[e];
+            if (candidate < dist[next])
+            {
+                dist[next] = candidate;
+                heap.push((unsigned long long)candidate, next);
+                heapOps++;
+            }
+        }
+    }
+    long long checksum = 0;
+    for (int v = 0; v < graph.nVertices; v++)
+        checksum += dist[v];
+    return checksum;
+}
+
+void benchHeapDijkstra(long long n)
+{
+    int nVertices = (int)n;
+    cout << "Dijkstra on random graph: " << nVertices << " vertices, degree 8" << endl;
+    Graph graph(nVertices, 8, 1000, 2025);
+    long long *dist = new long long[nVertices];
+    long long heapOps = 0;
+
+    Stopwatch watch;
+    long long checksum1 = dijkstraHeap(graph, dist, heapOps);
+    benchReport("Heap (lazy re-push)", heapOps, watch.elapsedMs());
+
+    watch.reset();
+    long long checksum2 = dijkstraIndexedHeap(graph, dist, heapOps);
+    benchReport("IndexedHeap (decrease-key)", heapOps, watch.elapsedMs());
+
+    watch.reset();
+    long long checksum3 = dijkstraRadixHeap(graph, dist, heapOps);
+    benchReport("RadixHeap (lazy re-push)", heapOps, watch.elapsedMs());
+
+    if (checksum1 != checksum2 || checksum1 != checksum3)
+        cout << "  MISMATCH: " << checksum1 << " != " << checksum2 << " or " << checksum3 << endl;
+    delete[] dist;
+}
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  BULK BUILD WORKLOAD  ///////////////////////
+//////////////////////////////////////////////////////////////////////
+
+static long long compareCount = 0;
+
+inline int countingComparator(int &lhs, int &rhs)
+{
+    compareCount++;
+    if (lhs < rhs)
+        return -1;
+    else if (lhs > rhs)
+        return +1;
+    else
+        return 0;
+}
+
+/*
+ * classicHeapify: textbook top-down reheapDown from n/2 (two comparisons per level),
+ *      kept here as the reference for counting comparisons
+ */
+static void classicHeapify(int *data, int n)
+{
+    for (int start = n / 2 - 1; start >= 0; start--)
+    {
+        int position = start;
+        while (true)
+        {
+            int child = position * 2 + 1;
+            if (child >= n)
+                break;
+            if (child + 1 < n && countingComparator(data[child + 1], data[child]) < 0)
+                child++;
+            if (countingComparator(data[child], data[position]) >= 0)
+                break;
+            swap(data[child], data[position]);
+            position = child;
+        }
+    }
+}
+
+void benchHeapBulkBuild(long long n)
+{
+    int size = (int)n;
+    cout << "Bulk build: " << size << " random ints" << endl;
+    int *data = new int[size];
+    mt19937 engine(2025);
+    for (int i = 0; i < size; i++)
+        data[i] = (int)(engine() >> 1);
+
+    {
+        Heap<int> heap(&countingComparator);
+        compareCount = 0;
+        Stopwatch watch;
+        for (int i = 0; i < size; i++)
+            heap.push(data[i]);
+        benchReport("push one by one", size, watch.elapsedMs());
+        cout << "    comparisons: " << compareCount << endl;
+    }
+    {
+        int *copy = new int[size];
+        memcpy(copy, data, size * sizeof(int));
+        compareCount = 0;
+        Stopwatch watch;
+        classicHeapify(copy, size);
+        benchReport("classic heapify (reference)", size, watch.elapsedMs());
+        cout << "    comparisons: " << compareCount << endl;
+        delete[] copy;
+    }
+    {
+        Heap<int> heap(&countingComparator);
+        compareCount = 0;
+        Stopwatch watch;
+        heap.heapify(data, size);
+        benchReport("Heap::heapify (bottom-up)", size, watch.elapsedMs());
+        cout << "    comparisons: " << compareCount << endl;
+    }
+    {
+        // batch of 3n/4 onto a heap of n/4: pushAll rebuilds the affected subtrees
+        int quarter = size / 4;
+        Heap<int> heap1(&countingComparator);
+        heap1.heapify(data, quarter);
+        compareCount = 0;
+        Stopwatch watch;
+        for (int i = quarter; i < size; i++)
+            heap1.push(data[i]);
+        benchReport("push 3n/4 onto heap of n/4", size - quarter, watch.elapsedMs());
+        cout << "    comparisons: " << compareCount << endl;
+
+        Heap<int> heap2(&countingComparator);
+        heap2.heapify(data, quarter);
+        compareCount = 0;
+        watch.reset();
+        heap2.pushAll(data + quarter, size - quarter);
+        benchReport("pushAll 3n/4 onto heap of n/4", size - quarter, watch.elapsedMs());
+        cout << "    comparisons: " << compareCount << endl;
+    }
+    {
+        Heap<int> heap(&countingComparator);
+        heap.heapify(data, size);
+        compareCount = 0;
+        Stopwatch watch;
+        long long checksum = 0;
+        while (!heap.empty())
+            checksum += heap.pop();
+        benchReport("pop all (bottom-up reheapDown)", size, watch.elapsedMs());
+        cout << "    comparisons: " << compareCount
+             << " (top-down needs ~2 log2(n) per pop)" << endl;
+    }
+    delete[] data;
+}
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  TOP-K WORKLOAD  ////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+inline int maxIntComparator(int &lhs, int &rhs)
+{
+    if (lhs < rhs)
+        return +1;
+    else if (lhs > rhs)
+        return -1;
+    else
+        return 0;
+}
+
+/*
+ * streamPart: the items [first, last) of a reproducible random stream
+ */
+static void streamPart(long long first, long long last, TopK<int> *top)
+{
+    mt19937 engine(2025 + first);
+    for (long long i = first; i < last; i++)
+        top->offer((int)(engine() >> 1));
+}
+
+void benchHeapTopK(long long n)
+{
+    const int K = 100;
+    cout << "Top-" << K << " of " << n << " random ints" << endl;
+
+    Stopwatch watch;
+    TopK<int> top(K, &maxIntComparator);
+    streamPart(0, n, &top);
+    benchReport("TopK, 1 thread", n, watch.elapsedMs());
+    XArrayList<int> best = top.sorted();
+
+    const int nThreads = 4;
+    watch.reset();
+    TopK<int> *parts[nThreads];
+    thread workers[nThreads];
+    for (int t = 0; t < nThreads; t++)
+    {
+        parts[t] = new TopK<int>(K, &maxIntComparator);
+        long long first = n * t / nThreads;
+        long long last = n * (t + 1) / nThreads;
+        workers[t] = thread(streamPart, first, last, parts[t]);
+    }
+    TopK<int> merged(K, &maxIntComparator);
+    for (int t = 0; t < nThreads; t++)
+    {
+        workers[t].join();
+        merged.merge(*parts[t]);
+        delete parts[t];
+    }
+    XArrayList<int> mergedBest = merged.sorted();
+    benchReport("TopK, 4 threads + merge", n, watch.elapsedMs());
+
+    // baseline: materialize the whole stream, then sort it with Heap
+    watch.reset();
+    XArrayList<int> all;
+    all.reserve((int)n);
+    mt19937 engine(2025);
+    for (long long i = 0; i < n; i++)
+        all.add((int)(engine() >> 1));
+    Heap<int> heap(&maxIntComparator);
+    heap.heapsort(all);
+    benchReport("full Heap::heapsort, then first k", n, watch.elapsedMs());
+
+    for (int i = 0; i < K; i++)
+        if (best.get(i) != all.get(i))
+        {
+            cout << "  MISMATCH at " << i << endl;
+            break;
+        }
+    if (mergedBest.size() != K)
+        cout << "  MISMATCH: merged size " << mergedBest.size() << endl;
+}
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  K-WAY MERGE WORKLOAD  //////////////////////
+//////////////////////////////////////////////////////////////////////
+
+void benchHeapKWayMerge(long long n)
+{
+    int total = (int)n;
+    cout << "K-way merge of " << total << " ints split in k sorted runs" << endl;
+    int *data = new int[total];
+    mt19937 engine(2025);
+    for (int i = 0; i < total; i++)
+        data[i] = (int)(engine() >> 1);
+
+    // baseline: concatenate all runs, then sort again
+    {
+        XArrayList<int> all;
+        all.reserve(total);
+        for (int i = 0; i < total; i++)
+            all.add(data[i]);
+        Stopwatch watch;
+        Heap<int> heap;
+        heap.heapsort(all);
+        benchReport("concatenate + Heap::heapsort", total, watch.elapsedMs());
+    }
+
+    for (int k = 2; k <= 1024; k *= 2)
+    {
+        XArrayList<int> *runs = new XArrayList<int>[k];
+        for (int r = 0; r < k; r++)
+        {
+            int first = (int)((long long)total * r / k);
+            int last = (int)((long long)total * (r + 1) / k);
+            runs[r].reserve(last - first);
+            for (int i = first; i < last; i++)
+                runs[r].add(data[i]);
+            Heap<int> heap;
+            heap.heapsort(runs[r]);
+        }
+
+        Stopwatch watch;
+        KWayMerger<int> merger;
+        for (int r = 0; r < k; r++)
+            merger.addRun(runs[r]);
+        XArrayList<int> output;
+        output.reserve(total);
+        merger.mergeTo(output);
+        double ms = watch.elapsedMs();
+        benchReport("KWayMerger k=" + to_string(k), total, ms);
+
+        for (int i = 1; i < output.size(); i++)
+            if (output.get(i - 1) > output.get(i))
+            {
+                cout << "  NOT SORTED at " << i << endl;
+                break;
+            }
+        delete[] runs;
+    }
+    delete[] data;
+}
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  HEAPSORT WORKLOAD  /////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+void benchHeapSort(long long n)
+{
+    int size = (int)n;
+    cout << "Heap::heapsort of " << size << " random ints" << endl;
+    const char *names[] = {"heapsort ascending", "heapsort descending"};
+    for (int order = 0; order < 2; order++)
+    {
+        XArrayList<int> list;
+        list.reserve(size);
+        mt19937 engine(2025);
+        for (int i = 0; i < size; i++)
+            list.add((int)(engine() >> 1));
+
+        Heap<int> heap(order == 0 ? 0 : &maxIntComparator);
+        Stopwatch watch;
+        heap.heapsort(list);
+        benchReport(names[order], size, watch.elapsedMs());
+
+        int *data = list.getData();
+        for (int i = 1; i < size; i++)
+            if (order == 0 ? data[i - 1] > data[i] : data[i - 1] < data[i])
+            {
+                cout << "  NOT SORTED at " << i << endl;
+                break;
+            }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  MULTIQUEUE WORKLOAD  ///////////////////////
+//////////////////////////////////////////////////////////////////////
+
+/*
+ * LockedHeap: baseline, one Heap<int> behind one mutex
+ */
+struct LockedHeap
+{
+    Heap<int> heap;
+    mutex lock;
+
+    void push(int item)
+    {
+        lock_guard<mutex> guard(lock);
+        heap.push(item);
+    }
+    bool tryPop(int &item)
+    {
+        lock_guard<mutex> guard(lock);
+        if (heap.empty())
+            return false;
+        item = heap.pop();
+        return true;
+    }
+};
+
+/*
+ * mixedWorker: ops pairs of (push random, pop), as in a worker pool
+ */
+template <class Q>
+static void mixedWorker(Q *queue, long long ops, int seed)
+{
+    mt19937 engine(seed);
+    int item;
+    for (long long i = 0; i < ops; i++)
+    {
+        queue->push((int)(engine() >> 1));
+        queue->tryPop(item);
+    }
+}
+
+template <class Q>
+static double runMixed(Q *queue, int nThreads, long long n)
+{
+    mt19937 engine(7);
+    for (int i = 0; i < 1024 * nThreads; i++)
+        queue->push((int)(engine() >> 1)); // prefill: pops never see an empty queue
+    Stopwatch watch;
+    thread *workers = new thread[nThreads];
+    for (int t = 0; t < nThreads; t++)
+        workers[t] = thread(mixedWorker<Q>, queue, n / nThreads, 100 + t);
+    for (int t = 0; t < nThreads; t++)
+        workers[t].join();
+    delete[] workers;
+    return watch.elapsedMs();
+}
+
+/*
+ * drainWorker: pop until empty, log[ticket] = popped key
+ *      the ticket gives one global order of the pops
+ */
+static void drainWorker(MultiQueue<int> *queue, int *log, atomic<int> *ticket)
+{
+    int item;
+    while (queue->tryPop(item))
+        log[ticket->fetch_add(1)] = item;
+}
+
+/*
+ * rankErrors: keys 0..m-1 popped in the order of log;
+ *      rank error of a pop = number of keys still queued that are smaller
+ *      (0 for an exact priority queue), counted with a Fenwick tree
+ */
+static void rankErrors(int *log, int m, double &mean, int &worst)
+{
+    int *tree = new int[m + 1];
+    for (int i = 1; i <= m; i++)
+        tree[i] = i & (-i); // all keys present
+    long long total = 0;
+    worst = 0;
+    for (int step = 0; step < m; step++)
+    {
+        int smaller = 0;
+        for (int i = log[step]; i > 0; i -= i & (-i))
+            smaller += tree[i];
+        for (int i = log[step] + 1; i <= m; i += i & (-i))
+            tree[i]--;
+        total += smaller;
+        worst = max(worst, smaller);
+    }
+    mean = m > 0 ? (double)total / m : 0;
+    delete[] tree;
+}
+
+void benchHeapMultiQueue(long long n)
+{
+    cout << "Worker pool: " << n << " (push, pop) pairs, split over the threads" << endl;
+    const int threadCounts[] = {1, 2, 4, 8, 16, 32, 64};
+    for (int nThreads : threadCounts)
+    {
+        LockedHeap locked;
+        double lockedMs = runMixed(&locked, nThreads, n);
+        MultiQueue<int> relaxed(nThreads);
+        double relaxedMs = runMixed(&relaxed, nThreads, n);
+
+        string suffix = ", " + to_string(nThreads) + " threads";
+        benchReport("Heap + one mutex" + suffix, n, lockedMs);
+        benchReport("MultiQueue" + suffix, n, relaxedMs);
+        cout << "    lock failures: " << relaxed.lockFailures() << endl;
+    }
+
+    const int m = (int)min(n, 1000000LL);
+    cout << "Rank error: drain " << m << " keys (0 = exact order)" << endl;
+    int *keys = new int[m];
+    int *log = new int[m];
+    for (int i = 0; i < m; i++)
+        keys[i] = i;
+    shuffle(keys, keys + m, mt19937(11));
+    for (int nThreads : threadCounts)
+    {
+        MultiQueue<int> relaxed(nThreads);
+        relaxed.sampleRankError(1000);
+        for (int i = 0; i < m; i++)
+            relaxed.push(keys[i]);
+        atomic<int> ticket(0);
+        thread *workers = new thread[nThreads];
+        for (int t = 0; t < nThreads; t++)
+            workers[t] = thread(drainWorker, &relaxed, log, &ticket);
+        for (int t = 0; t < nThreads; t++)
+            workers[t].join();
+        delete[] workers;
+
+        double mean;
+        int worst;
+        rankErrors(log, ticket.load(), mean, worst);
+        cout << "  " << setw(3) << nThreads << " threads, " << setw(5) << relaxed.shardCount() << " heaps:"
+             << "  mean " << fixed << setprecision(2) << mean << ", max " << worst
+             << "  (sampled by the queue: mean " << relaxed.meanRankError()
+             << ", max " << relaxed.maxRankError() << ")" << endl;
+    }
+    delete[] keys;
+    delete[] log;
+}
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  MELD WORKLOAD  /////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+/*
+ * meldInto(a, b): Heap<T> has no meld: every item of b is pushed again
+ */
+static void meldInto(Heap<int> &a, Heap<int> &b)
+{
+    for (Heap<int>::Iterator it = b.begin(); it != b.end(); it++)
+        a.push(*it);
+    b.clear();
+}
+
+static void meldInto(PairingHeap<int> &a, PairingHeap<int> &b)
+{
+    a.meld(b);
+}
+
+/*
+ * rebalance: shards melded pairwise at random (a rebalance),
+ *      the emptied shard takes back a few items of the melded one
+ */
+template <class H>
+static void rebalance(H *shards, int nShards, int melds, mt19937 &engine)
+{
+    for (int step = 0; step < melds; step++)
+    {
+        int a = (int)(engine() % nShards);
+        int b = (int)((a + 1 + engine() % (nShards - 1)) % nShards);
+        meldInto(shards[a], shards[b]);
+        for (int k = 0; k < 4 && !shards[a].empty(); k++)
+            shards[b].push(shards[a].pop());
+    }
+}
+
+template <class H>
+static long long runMeld(const string &name, int nShards, long long n)
+{
+    const int melds = 8 * nShards;
+    H *shards = new H[nShards];
+    mt19937 engine(2025);
+    for (long long i = 0; i < n; i++)
+        shards[i % nShards].push((int)(engine() >> 1));
+
+    Stopwatch watch;
+    rebalance(shards, nShards, melds, engine);
+    benchReport(name + ", melds", melds, watch.elapsedMs());
+
+    watch.reset();
+    long long checksum = 0;
+    for (int s = 0; s < nShards; s++)
+        while (!shards[s].empty())
+            checksum += shards[s].pop();
+    benchReport(name + ", drain", n, watch.elapsedMs());
+    delete[] shards;
+    return checksum;
+}
+
+void benchHeapMeld(long long n)
+{
+    const int nShards = 1024;
+    cout << nShards << " shards holding " << n << " ints: "
+         << 8 * nShards << " random melds, then drain" << endl;
+    long long checksum1 = runMeld<Heap<int>>("Heap (push every item)", nShards, n);
+    long long checksum2 = runMeld<PairingHeap<int>>("PairingHeap (O(1) meld)", nShards, n);
+    if (checksum1 != checksum2)
+        cout << "  MISMATCH: " << checksum1 << " != " << checksum2 << endl;
+}
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  LARGE HEAP LAYOUT WORKLOAD  ////////////////
+//////////////////////////////////////////////////////////////////////
+
+/*
+ * runLayout: push n random ints, then pop n/10 of them,
+ *      timing and hardware counters for each phase
+ */
+template <class H>
+static long long runLayout(const string &name, H &heap, long long n)
+{
+    PerfCounters counters;
+    mt19937 engine(2025);
+
+    Stopwatch watch;
+    counters.start();
+    for (long long i = 0; i < n; i++)
+        heap.push((int)(engine() >> 1));
+    counters.stop();
+    benchReport(name + ", push", n, watch.elapsedMs());
+    counters.report();
+
+    long long pops = n / 10;
+    long long checksum = 0;
+    watch.reset();
+    counters.start();
+    for (long long i = 0; i < pops; i++)
+        checksum += heap.pop();
+    counters.stop();
+    benchReport(name + ", pop", pops, watch.elapsedMs());
+    counters.report();
+    return checksum;
+}
+
+void benchHeapBlockLayout(long long n)
+{
+    cout << "Heap of " << n << " ints, classic vs B-heap (4 KiB pages) layout" << endl;
+    if (!PerfCounters().available())
+        cout << "  (hardware counters not available: perf_event_open failed)" << endl;
+    long long checksum1, checksum2;
+    {
+        Heap<int> heap;
+        checksum1 = runLayout("Heap", heap, n);
+    }
+    {
+        BlockHeap<int> heap;
+        checksum2 = runLayout("BlockHeap", heap, n);
+    }
+    if (checksum1 != checksum2)
+        cout << "  MISMATCH: " << checksum1 << " != " << checksum2 << endl;
+}
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  EXTERNAL MEMORY WORKLOAD  //////////////////
+//////////////////////////////////////////////////////////////////////
+
+template <class H>
+static long long pushPopAll(const string &name, H &heap, long long n)
+{
+    mt19937_64 engine(2025);
+    Stopwatch watch;
+    for (long long i = 0; i < n; i++)
+        heap.push((long long)(engine() >> 1));
+    benchReport(name + ", push", n, watch.elapsedMs());
+
+    watch.reset();
+    long long checksum = 0, previous = -1;
+    for (long long i = 0; i < n; i++)
+    {
+        long long item = heap.pop();
+        if (item < previous)
+            cout << "  NOT SORTED at " << i << endl;
+        previous = item;
+        checksum += item & 0xFFFF;
+    }
+    benchReport(name + ", pop", n, watch.elapsedMs());
+    return checksum;
+}
+
+void benchHeapExternal(long long n)
+{
+    const int memoryItems = (int)max(1LL, n / 16);
+    cout << n << " long long, external heap limited to " << memoryItems << " items in memory" << endl;
+    long long checksum1, checksum2;
+    {
+        Heap<long long> heap;
+        checksum1 = pushPopAll("Heap (all in memory)", heap, n);
+    }
+    {
+        ExternalHeap<long long> heap(0, memoryItems);
+        checksum2 = pushPopAll("ExternalHeap", heap, n);
+        cout << "    " << heap.getStats().toString() << endl;
+    }
+    if (checksum1 != checksum2)
+        cout << "  MISMATCH: " << checksum1 << " != " << checksum2 << endl;
+}
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  TIMER WORKLOAD  ////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+/*
+ * HeapTimers: baseline timer queue, Heap<DistEntry> ordered by deadline
+ *      (dist: deadline, vertex: timer id), cancellation by a flag:
+ *      Heap::remove is a linear search, out of question for millions of timers
+ */
+struct HeapTimers
+{
+    Heap<DistEntry> heap;
+    XArrayList<char> cancelled;
+
+    HeapTimers() : heap(&distEntryComparator) {}
+    long long schedule(long long deadline, int id)
+    {
+        heap.push(DistEntry{deadline, id});
+        cancelled.add(0);
+        return cancelled.size() - 1;
+    }
+    bool cancel(long long handle)
+    {
+        cancelled.set((int)handle, 1);
+        return true;
+    }
+    int advance(long long now, XArrayList<int> &expired)
+    {
+        int before = expired.size();
+        while (!heap.empty() && heap.peek().dist <= now)
+        {
+            DistEntry entry = heap.pop();
+            if (!cancelled.get(entry.vertex))
+                expired.add(entry.vertex);
+        }
+        return expired.size() - before;
+    }
+};
+
+/*
+ * timerChurn: n timers, 20 scheduled per tick, deadlines 1..65536 ticks ahead
+ *      (1% of them 2^33 ticks ahead); 3 timers out of 4 are cancelled
+ *      a few ticks later; return the number of timers expired
+ */
+template <class S>
+static long long timerChurn(S &timers, long long n, long long &ops)
+{
+    const int PER_TICK = 20;
+    const int WINDOW = 1024; // cancel a timer scheduled up to 1024 timers ago
+    mt19937 engine(2025);
+    long long *handles = new long long[WINDOW];
+    XArrayList<int> expired;
+    long long now = 0, total = 0;
+    ops = 0;
+    for (long long i = 0; i < n; i++)
+    {
+        long long delay = engine() % 100 == 0 ? (1LL << 33) : 1 + engine() % 65536;
+        handles[i % WINDOW] = timers.schedule(now + delay, (int)i);
+        ops++;
+        if (i >= WINDOW && engine() % 4 != 0)
+        {
+            timers.cancel(handles[(i + 1) % WINDOW]); // the oldest timer of the window
+            ops++;
+        }
+        if (i % PER_TICK == PER_TICK - 1)
+        {
+            now++;
+            total += timers.advance(now, expired);
+            expired.clear();
+        }
+    }
+    total += timers.advance(now + (1LL << 34), expired);
+    delete[] handles;
+    return total;
+}
+
+void benchHeapTimers(long long n)
+{
+    cout << n << " timers, 20 per tick, 3 out of 4 cancelled" << endl;
+    long long ops = 0;
+
+    Stopwatch watch;
+    HeapTimers heapTimers;
+    long long expired1 = timerChurn(heapTimers, n, ops);
+    benchReport("Heap + cancelled flags", ops, watch.elapsedMs());
+
+    watch.reset();
+    TimerScheduler<int> wheel;
+    long long expired2 = timerChurn(wheel, n, ops);
+    benchReport("TimerScheduler (wheel + far Heap)", ops, watch.elapsedMs());
+
+    if (expired1 != expired2)
+        cout << "  MISMATCH: " << expired1 << " != " << expired2 << endl;
+}
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  SORTED VIEW WORKLOAD  //////////////////////
+//////////////////////////////////////////////////////////////////////
+
+void benchHeapSortedView(long long n)
+{
+    const int K = 1000;
+    cout << "First " << K << " items in priority order of a heap of " << n << " ints" << endl;
+    Heap<int> heap;
+    mt19937 engine(2025);
+    for (long long i = 0; i < n; i++)
+        heap.push((int)(engine() >> 1));
+
+    Stopwatch watch;
+    Heap<int> copy(heap); // deep copy, then pop
+    long long checksum1 = 0;
+    for (int i = 0; i < K; i++)
+        checksum1 += copy.pop();
+    benchReport("copy + pop", K, watch.elapsedMs());
+
+    watch.reset();
+    Heap<int>::SortedView view = heap.sortedView();
+    long long checksum2 = 0;
+    for (int i = 0; i < K; i++)
+        checksum2 += view.next();
+    benchReport("sortedView", K, watch.elapsedMs());
+
+    watch.reset();
+    XArrayList<int> drained;
+    heap.drainTo(drained);
+    benchReport("drainTo (all items)", n, watch.elapsedMs());
+
+    if (checksum1 != checksum2)
+        cout << "  MISMATCH: " << checksum1 << " != " << checksum2 << endl;
+}
@@ -0,0 +1,689 @@
+#include "bench/bench_list.h"
+
+#include <algorithm>
+#include <execution>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "bench/bench_util.h"
+#include "bench/alloc_counter.h"
+#include "list/XArrayList.h"
+#include "list/SegmentedList.h"
+#include "list/ListAlgo.h"
+#include "list/GapList.h"
+#include "list/CowArrayList.h"
+#include "list/PackedList.h"
+#include "list/ConcurrentAppendList.h"
+#include "util/SimdLib.h"
+#include "app/inventory_compressor.h"
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  SEGMENTED APPEND WORKLOAD  /////////////////
+//////////////////////////////////////////////////////////////////////
+
+/*
+ * appendAll: n adds to an empty list; report the time and the peak
+ *      memory above the memory in use before the list was created
+ */
+template <class L, class T>
+static long long appendAll(const string &name, long long n, T (*makeItem)(long long))
+{
+    AllocCounter::reset();
+    long long before = AllocCounter::liveBytes();
+    long long checksum = 0;
+    Stopwatch watch;
+    {
+        L list;
+        for (long long i = 0; i < n; i++)
+            list.add(makeItem(i));
+        checksum = list.size();
+        benchReport(name, n, watch.elapsedMs());
+    }
+    cout << "    peak memory: " << (AllocCounter::peakBytes() - before) / 1024 << " KB, "
+         << "allocations: " << AllocCounter::allocations() << endl;
+    return checksum;
+}
+
+static int makeInt(long long i)
+{
+    return (int)i;
+}
+
+static string makeString(long long i)
+{
+    return "item-" + to_string(i);
+}
+
+void benchListSegmentedAppend(long long n)
+{
+    cout << "Append " << n << " items to an empty list" << endl;
+    long long checksum = 0;
+    checksum += appendAll<XArrayList<int>, int>("XArrayList<int>", n, makeInt);
+    checksum += appendAll<SegmentedList<int>, int>("SegmentedList<int>", n, makeInt);
+    long long m = n / 10;
+    checksum += appendAll<XArrayList<string>, string>("XArrayList<string>", m, makeString);
+    checksum += appendAll<SegmentedList<string>, string>("SegmentedList<string>", m, makeString);
+    if (checksum != 2 * (n + m))
+        cout << "  MISMATCH: " << checksum << endl;
+}
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  BULK EDIT WORKLOAD  ////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+static bool isMultipleOf3(int &item)
+{
+    return item % 3 == 0;
+}
+
+static bool isMultipleOf3(string &item)
+{
+    return item.size() % 3 == 0;
+}
+
+/*
+ * bulkEdits: on a list of n items, compare one item at a time (add(index),
+ *      removeAt) with the bulk operations; m = number of items edited
+ */
+template <class T>
+static long long bulkEdits(const string &type, long long n, T (*makeItem)(long long))
+{
+    int m = (int)min(n / 10, 2000LL);
+    T *batch = new T[m];
+    for (int i = 0; i < m; i++)
+        batch[i] = makeItem(i);
+    long long checksum = 0;
+
+    Stopwatch watch;
+    XArrayList<T> list;
+    for (long long i = 0; i < n; i++)
+        list.add(makeItem(i));
+    benchReport(type + " add x n", n, watch.elapsedMs());
+    watch.reset();
+    XArrayList<T> bulk;
+    for (long long i = 0; i < n; i += m)
+        bulk.addAll(batch, (int)min((long long)m, n - i));
+    benchReport(type + " addAll", n, watch.elapsedMs());
+
+    int middle = list.size() / 2;
+    watch.reset();
+    for (int i = 0; i < m; i++)
+        list.add(middle + i, batch[i]);
+    benchReport(type + " add(index) x m", m, watch.elapsedMs());
+    watch.reset();
+    bulk.insertRange(middle, batch, batch + m);
+    benchReport(type + " insertRange", m, watch.elapsedMs());
+
+    watch.reset();
+    for (int i = 0; i < m; i++)
+        list.removeAt(middle);
+    benchReport(type + " removeAt x m", m, watch.elapsedMs());
+    watch.reset();
+    bulk.removeRange(middle, middle + m);
+    benchReport(type + " removeRange", m, watch.elapsedMs());
+
+    // remove every item matching the predicate
+    XArrayList<T> copy(list);
+    watch.reset();
+    int removed = 0;
+    for (int i = 0; i < copy.size() && removed < m; i++)
+        if (isMultipleOf3(copy.get(i)))
+        {
+            copy.removeAt(i--);
+            removed++;
+        }
+    benchReport(type + " removeAt loop (first m)", removed, watch.elapsedMs());
+    watch.reset();
+    removed = list.removeIf(isMultipleOf3);
+    benchReport(type + " removeIf (all)", removed, watch.elapsedMs());
+
+    checksum += list.size() + bulk.size();
+    delete[] batch;
+    return checksum;
+}
+
+void benchListBulkOps(long long n)
+{
+    cout << "Bulk edits in the middle of a list of " << n << " items" << endl;
+    long long checksum = 0;
+    checksum += bulkEdits<int>("int", n, makeInt);
+    checksum += bulkEdits<string>("string", n / 10, makeString);
+    if (checksum <= 0)
+        cout << "  MISMATCH: " << checksum << endl;
+}
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  LINEAR SEARCH WORKLOAD  ////////////////////
+//////////////////////////////////////////////////////////////////////
+
+/*
+ * searchMissing: search a value absent from a list of size items,
+ *      repeated until about "work" items are scanned;
+ *      ops reported = items scanned
+ */
+template <class T>
+static void searchMissing(const string &type, long long size, long long work)
+{
+    XArrayList<T> list;
+    list.reserve((int)size);
+    for (long long i = 0; i < size; i++)
+        list.add((T)(i % 100));
+    T missing = (T)101;
+    long long repeats = max(1LL, work / size);
+    long long found = 0;
+
+    Stopwatch watch;
+    for (long long r = 0; r < repeats; r++)
+        found += scalarIndexOf(list.getData(), list.size(), missing);
+    benchReport(type + " scalar, size " + to_string(size), repeats * size, watch.elapsedMs());
+    watch.reset();
+    for (long long r = 0; r < repeats; r++)
+        found += list.indexOf(missing);
+    benchReport(type + " indexOf, size " + to_string(size), repeats * size, watch.elapsedMs());
+    if (found != -2 * repeats)
+        cout << "  MISMATCH: " << found << endl;
+}
+
+void benchListSimdSearch(long long n)
+{
+#ifdef __AVX2__
+    cout << "indexOf of a missing value (AVX2), up to " << n << " items" << endl;
+#else
+    cout << "indexOf of a missing value (SSE2), up to " << n << " items" << endl;
+#endif
+    long long work = max(n, 200000000LL);
+    long long sizes[] = {1000, 100000, 10000000};
+    for (long long size : sizes)
+        if (size < n)
+            searchMissing<int>("int", size, work);
+    searchMissing<int>("int", n, work);
+    long long middle = min(n, 100000LL);
+    searchMissing<char>("char", middle, work);
+    searchMissing<double>("double", middle, work);
+}
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  SMALL LIST WORKLOAD  ///////////////////////
+//////////////////////////////////////////////////////////////////////
+
+/*
+ * Huffman tree build (tree nodes with <= treeOrder children)
+ * and inventory load (rows of 1-5 attributes): allocations counted
+ * by the global operator new of the bench binary
+ */
+static int charHash(char &key, int capacity)
+{
+    return (unsigned char)key % capacity;
+}
+
+void benchListSmallAlloc(long long n)
+{
+    int builds = (int)max(1LL, n / 256);
+    cout << builds << " Huffman tree builds (256 symbols, order 4), "
+         << n << " products loaded" << endl;
+    XArrayList<pair<char, int>> symbols;
+    for (int c = 0; c < 256; c++)
+        symbols.add(make_pair((char)c, 1 + (c * 37) % 101));
+
+    AllocCounter::reset();
+    Stopwatch watch;
+    long long checksum = 0;
+    for (int b = 0; b < builds; b++)
+    {
+        HuffmanTree<4> tree;
+        tree.build(symbols);
+        xMap<char, string> table(charHash);
+        tree.generateCodes(table);
+        checksum += table.size();
+    }
+    benchReport("HuffmanTree<4> build + codes", builds, watch.elapsedMs());
+    cout << "    allocations per build: " << AllocCounter::allocations() / builds << endl;
+
+    AllocCounter::reset();
+    watch.reset();
+    {
+        InventoryManager inventory;
+        for (long long i = 0; i < n; i++)
+        {
+            List1D<InventoryAttribute> attributes;
+            attributes.add(InventoryAttribute("weight", (double)(i % 97)));
+            attributes.add(InventoryAttribute("depth", (double)(i % 13)));
+            if (i % 2 == 0)
+                attributes.add(InventoryAttribute("color", (double)(i % 7)));
+            inventory.addProduct(attributes, "product", (int)(i % 50));
+        }
+        checksum += inventory.size();
+        benchReport("InventoryManager::addProduct", n, watch.elapsedMs());
+    }
+    cout << "    allocations per product: " << (double)AllocCounter::allocations() / n << endl;
+    if (checksum != 256LL * builds + n)
+        cout << "  MISMATCH: " << checksum << endl;
+}
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  SORT WORKLOAD  /////////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+struct QueryRecord
+{
+    string name;
+    double value;
+    int quantity;
+
+    bool operator==(const QueryRecord &other) const { return name == other.name; }
+    bool operator<(const QueryRecord &other) const
+    {
+        return value < other.value || (value == other.value && quantity < other.quantity);
+    }
+    friend ostream &operator<<(ostream &os, const QueryRecord &record)
+    {
+        os << record.name;
+        return os;
+    }
+};
+
+static int compareRecords(QueryRecord &lhs, QueryRecord &rhs)
+{
+    if (lhs.value != rhs.value)
+        return lhs.value < rhs.value ? -1 : 1;
+    return lhs.quantity - rhs.quantity;
+}
+
+/*
+ * bubbleSortRecords: the sort of InventoryManager::query (ascending):
+ *      three parallel List1D, bubble sort with get/set
+ */
+static void bubbleSortRecords(List1D<string> &result, List1D<double> &resultValue, List1D<int> &resultQuantity)
+{
+    for (int i = 0; i < result.size() - 1; i++)
+        for (int j = 0; j < result.size() - i - 1; j++)
+        {
+            bool shouldSwap = resultValue.get(j) > resultValue.get(j + 1) ||
+                              (resultValue.get(j) == resultValue.get(j + 1) && resultQuantity.get(j) > resultQuantity.get(j + 1));
+            if (shouldSwap)
+            {
+                string tempName = result.get(j);
+                result.set(j, result.get(j + 1));
+                result.set(j + 1, tempName);
+                double tempValue = resultValue.get(j);
+                resultValue.set(j, resultValue.get(j + 1));
+                resultValue.set(j + 1, tempValue);
+                int tempQuantity = resultQuantity.get(j);
+                resultQuantity.set(j, resultQuantity.get(j + 1));
+                resultQuantity.set(j + 1, tempQuantity);
+            }
+        }
+}
+
+void benchListSort(long long n)
+{
+    int m = (int)min(n, 5000LL); // the bubble sort is O(m^2)
+    cout << "Sort " << m << " query records, then " << n << " ints" << endl;
+    mt19937 engine(44);
+    List1D<string> names;
+    List1D<double> values;
+    List1D<int> quantities;
+    XArrayList<QueryRecord> records;
+    for (int i = 0; i < m; i++)
+    {
+        QueryRecord record{"product-" + to_string(i), (double)(engine() % 1000), (int)(engine() % 50)};
+        names.add(record.name);
+        values.add(record.value);
+        quantities.add(record.quantity);
+        records.add(record);
+    }
+
+    Stopwatch watch;
+    bubbleSortRecords(names, values, quantities);
+    benchReport("bubble sort (InventoryManager::query)", m, watch.elapsedMs());
+    watch.reset();
+    records.stableSort(compareRecords);
+    benchReport("XArrayList::stableSort", m, watch.elapsedMs());
+    for (int i = 0; i < m; i++)
+        if (records.get(i).name != names.get(i))
+        {
+            cout << "  MISMATCH at " << i << endl;
+            break;
+        }
+
+    XArrayList<int> numbers;
+    numbers.reserve((int)n);
+    for (long long i = 0; i < n; i++)
+        numbers.add((int)(engine() >> 1));
+    XArrayList<int> copy(numbers);
+    watch.reset();
+    copy.sort();
+    benchReport("sort", n, watch.elapsedMs());
+    copy = numbers;
+    watch.reset();
+    copy.stableSort();
+    benchReport("stableSort", n, watch.elapsedMs());
+    copy = numbers;
+    watch.reset();
+    copy.sort(std::execution::par);
+    benchReport("sort(par) [" + to_string(thread::hardware_concurrency()) + " hw threads]", n, watch.elapsedMs());
+    copy = numbers;
+    watch.reset();
+    copy.stableSort(std::execution::par);
+    benchReport("stableSort(par)", n, watch.elapsedMs());
+    if (!std::is_sorted(copy.begin(), copy.end()))
+        cout << "  MISMATCH: not sorted" << endl;
+}
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  LISTALGO SCALING WORKLOAD  /////////////////
+//////////////////////////////////////////////////////////////////////
+
+void benchListAlgoScaling(long long n)
+{
+    cout << "Sort " << n << " ints with 1-8 threads ("
+         << thread::hardware_concurrency() << " hardware threads)" << endl;
+    mt19937 engine(45);
+    XArrayList<int> numbers;
+    numbers.reserve((int)n);
+    for (long long i = 0; i < n; i++)
+        numbers.add((int)engine());
+
+    XArrayList<int> copy(numbers);
+    Stopwatch watch;
+    copy.stableSort();
+    benchReport("std::stable_sort", n, watch.elapsedMs());
+    for (int threads = 1; threads <= 8; threads *= 2)
+    {
+        copy = numbers;
+        watch.reset();
+        parallelMergeSort(copy, 0, threads);
+        benchReport("parallelMergeSort, " + to_string(threads) + " threads", n, watch.elapsedMs());
+    }
+    for (int threads = 1; threads <= 8; threads *= 2)
+    {
+        copy = numbers;
+        watch.reset();
+        radixSort(copy, threads);
+        benchReport("radixSort, " + to_string(threads) + " threads", n, watch.elapsedMs());
+    }
+    if (!std::is_sorted(copy.begin(), copy.end()))
+        cout << "  MISMATCH: not sorted" << endl;
+
+    // searches in the sorted list
+    long long queries = 1000000, hits = 0;
+    watch.reset();
+    for (long long q = 0; q < queries; q++)
+        hits += binarySearch(copy, (int)engine()) != -1;
+    benchReport("binarySearch (XArrayList)", queries, watch.elapsedMs());
+    DLinkedList<int> linked;
+    for (int i = 0; i < min(copy.size(), 100000); i++)
+        linked.add(copy.get(i * (copy.size() / min(copy.size(), 100000))));
+    long long linkedQueries = 1000;
+    watch.reset();
+    for (long long q = 0; q < linkedQueries; q++)
+        hits += lowerBound(linked, (int)engine()) == linked.size();
+    benchReport("lowerBound (DLinkedList, 100K)", linkedQueries, watch.elapsedMs());
+    if (hits < 0)
+        cout << "  MISMATCH: " << hits << endl;
+}
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  GAP LIST WORKLOAD  /////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+/*
+ * editAround: "edits" add(index)/removeAt(index) on a list of "size" items
+ *  + local: the cursor moves by -8..+8 between edits (pick list edited near a cursor)
+ *  + random: any index
+ */
+template <class L>
+static long long editAround(const string &name, int size, long long edits, bool local)
+{
+    L list;
+    for (int i = 0; i < size; i++)
+        list.add(i);
+    mt19937 engine(46);
+    int cursor = size / 2;
+    long long checksum = 0;
+    Stopwatch watch;
+    for (long long e = 0; e < edits; e++)
+    {
+        if (local)
+            cursor += (int)(engine() % 17) - 8;
+        else
+            cursor = (int)(engine() % (unsigned int)list.size());
+        cursor = max(0, min(cursor, list.size() - 1));
+        if (engine() & 1)
+            list.add(cursor, (int)e);
+        else
+            checksum += list.removeAt(cursor);
+    }
+    benchReport(name, edits, watch.elapsedMs());
+    return checksum + list.size();
+}
+
+void benchListGapEdits(long long n)
+{
+    int size = (int)n;
+    long long edits = 50000;
+    cout << edits << " edits on a list of " << size << " ints" << endl;
+    long long a = editAround<XArrayList<int>>("XArrayList, cursor-local", size, edits, true);
+    long long b = editAround<GapList<int>>("GapList, cursor-local", size, edits, true);
+    long long c = editAround<XArrayList<int>>("XArrayList, random", size, edits / 10, false);
+    long long d = editAround<GapList<int>>("GapList, random", size, edits / 10, false);
+    if (a != b || c != d)
+        cout << "  MISMATCH: " << a << " " << b << " " << c << " " << d << endl;
+}
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  CONCURRENT APPEND WORKLOAD  ////////////////
+//////////////////////////////////////////////////////////////////////
+
+/*
+ * appendInThreads: nThreads threads append n items in total to "add"
+ */
+template <class Add>
+static double appendInThreads(int nThreads, long long n, Add add)
+{
+    Stopwatch watch;
+    vector<thread> threads;
+    for (int t = 0; t < nThreads; t++)
+        threads.emplace_back([&add, t, nThreads, n]()
+                             {
+                                 for (long long i = t; i < n; i += nThreads)
+                                     add((int)i); });
+    for (thread &worker : threads)
+        worker.join();
+    return watch.elapsedMs();
+}
+
+void benchListConcurrentAppend(long long n)
+{
+    cout << "Append " << n << " ints from 1-64 threads ("
+         << thread::hardware_concurrency() << " hardware threads)" << endl;
+    for (int nThreads = 1; nThreads <= 64; nThreads *= 4)
+    {
+        XArrayList<int> locked;
+        mutex lock;
+        double ms = appendInThreads(nThreads, n, [&](int item)
+                                    {
+                                        lock_guard<mutex> guard(lock);
+                                        locked.add(item); });
+        benchReport("mutex + XArrayList, " + to_string(nThreads) + " threads", n, ms);
+
+        ConcurrentAppendList<int> concurrent;
+        ms = appendInThreads(nThreads, n, [&](int item)
+                             { concurrent.add(item); });
+        benchReport("ConcurrentAppendList, " + to_string(nThreads) + " threads", n, ms);
+        if (concurrent.size() != n || locked.size() != n)
+            cout << "  MISMATCH: " << concurrent.size() << " " << locked.size() << endl;
+    }
+
+    // conversion to XArrayList
+    ConcurrentAppendList<int> sized((int)n), grown;
+    for (long long i = 0; i < n; i++)
+    {
+        sized.add((int)i);
+        grown.add((int)i);
+    }
+    XArrayList<int> list;
+    Stopwatch watch;
+    sized.moveTo(list);
+    benchReport("moveTo, one segment (adopted)", n, watch.elapsedMs());
+    int segments = grown.segmentCount();
+    watch.reset();
+    grown.moveTo(list);
+    benchReport("moveTo, " + to_string(segments) + " segments (moved)", n, watch.elapsedMs());
+}
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  SNAPSHOT WORKLOAD  /////////////////////////
+//////////////////////////////////////////////////////////////////////
+
+/*
+ * reportCopies: time and allocations of one inventory-level operation
+ */
+static void reportCopies(const string &name, long long ops, Stopwatch &watch)
+{
+    double ms = watch.elapsedMs();
+    long long allocations = AllocCounter::allocations();
+    benchReport(name, ops, ms);
+    cout << "    allocations: " << allocations << " (" << (double)allocations / ops << " per op)" << endl;
+    AllocCounter::reset();
+    watch.reset();
+}
+
+void benchListSnapshots(long long n)
+{
+    cout << "Inventory of " << n << " products, read-only copies" << endl;
+    InventoryManager inventory;
+    for (long long i = 0; i < n; i++)
+    {
+        List1D<InventoryAttribute> attributes;
+        attributes.add(InventoryAttribute("weight", (double)(i % 97)));
+        attributes.add(InventoryAttribute("depth", (double)(i % 13)));
+        if (i % 2 == 0)
+            attributes.add(InventoryAttribute("color", (double)(i % 7)));
+        inventory.addProduct(attributes, "product-" + to_string(i), (int)(i % 50));
+    }
+
+    long long checksum = 0;
+    AllocCounter::reset();
+    Stopwatch watch;
+    for (int i = 0; i < inventory.size(); i++)
+        checksum += inventory.getProductAttributes(i).size();
+    reportCopies("getProductAttributes", n, watch);
+
+    {
+        InventoryManager copy(inventory);
+        checksum += copy.size();
+        reportCopies("InventoryManager copy", n, watch);
+    }
+    AllocCounter::reset();
+    watch.reset();
+
+    checksum += inventory.getProductNames().size() + inventory.getQuantities().size();
+    reportCopies("getProductNames + getQuantities", 2, watch);
+
+    List1D<string> found = inventory.query("weight", 0, 0, 49, true);
+    checksum += found.size();
+    reportCopies("query (one getRow per product)", n, watch);
+
+    // list level: n strings copied 100 times, the copies only read
+    XArrayList<string> deep;
+    CowArrayList<string> shared;
+    for (long long i = 0; i < n; i++)
+    {
+        deep.add("attribute-name-" + to_string(i)); // longer than the inline string buffer
+        shared.add("attribute-name-" + to_string(i));
+    }
+    AllocCounter::reset();
+    watch.reset();
+    for (int copies = 0; copies < 100; copies++)
+    {
+        XArrayList<string> copy(deep);
+        checksum += copy.size();
+    }
+    reportCopies("XArrayList<string> copy", 100, watch);
+    for (int copies = 0; copies < 100; copies++)
+    {
+        CowArrayList<string> copy(shared);
+        checksum += copy.size();
+    }
+    reportCopies("CowArrayList<string> copy", 100, watch);
+    CowArrayList<string> changed(shared);
+    changed.set(0, "changed");
+    reportCopies("CowArrayList<string> copy + 1st set", 1, watch);
+
+    // 2 or 3 attributes per product, then the sizes of the copies
+    if (checksum != 2 * n + (n + 1) / 2 + 3 * n + found.size() + 200 * n)
+        cout << "  MISMATCH: " << checksum << endl;
+}
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  PACKED LIST WORKLOAD  //////////////////////
+//////////////////////////////////////////////////////////////////////
+
+/*
+ * scanArrayList: memory of n items in an XArrayList, time of count + indexOf
+ */
+template <class T>
+static long long scanArrayList(const string &name, long long n, int maxValue)
+{
+    AllocCounter::reset();
+    long long before = AllocCounter::liveBytes();
+    XArrayList<T> list;
+    for (long long i = 0; i < n; i++)
+        list.add((T)((i * 7 + i / 5) % maxValue));
+    list.add((T)maxValue);
+    cout << "  " << name << ": " << (AllocCounter::liveBytes() - before) / 1024 << " KB" << endl;
+
+    Stopwatch watch;
+    long long found = 0;
+    for (int round = 0; round < 10; round++)
+    {
+        T *data = list.getData();
+        for (int idx = 0; idx < list.size(); idx++)
+            found += data[idx] == (T)0;
+    }
+    benchReport("    count(0) x10", 10 * n, watch.elapsedMs());
+    watch.reset();
+    found += list.indexOf((T)maxValue);
+    benchReport("    indexOf", n, watch.elapsedMs());
+    return found;
+}
+
+template <int Bits>
+static long long scanPackedList(const string &name, long long n)
+{
+    AllocCounter::reset();
+    long long before = AllocCounter::liveBytes();
+    PackedList<Bits> list;
+    for (long long i = 0; i < n; i++)
+        list.add((int)((i * 7 + i / 5) % PackedList<Bits>::MAX_VALUE));
+    list.add(PackedList<Bits>::MAX_VALUE);
+    cout << "  " << name << ": " << (AllocCounter::liveBytes() - before) / 1024 << " KB" << endl;
+
+    Stopwatch watch;
+    long long found = 0;
+    for (int round = 0; round < 10; round++)
+        found += list.count(0);
+    benchReport("    count(0) x10", 10 * n, watch.elapsedMs());
+    watch.reset();
+    found += list.indexOf(PackedList<Bits>::MAX_VALUE);
+    benchReport("    indexOf", n, watch.elapsedMs());
+    watch.reset();
+    list.fill(0, (int)n, 0);
+    benchReport("    fill", n, watch.elapsedMs());
+    return found;
+}
+
+void benchListPacked(long long n)
+{
+    cout << n << " flags and " << n << " values 0..3, count and search" << endl;
+    // the last item is the only one equal to the maximum value: indexOf scans everything
+    long long flags = scanArrayList<bool>("XArrayList<bool>", n, 1);
+    long long packedFlags = scanPackedList<1>("PackedList<1>", n);
+    long long values = scanArrayList<int>("XArrayList<int>, values 0..3", n, 3);
+    long long packedValues = scanPackedList<2>("PackedList<2>", n);
+    if (flags != packedFlags || values != packedValues)
+        cout << "  MISMATCH: " << flags << " " << packedFlags << " " << values << " " << packedValues << endl;
+}
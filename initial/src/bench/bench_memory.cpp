@@ -0,0 +1,128 @@
+#include "bench/bench_memory.h"
+
+#include <string>
+#include "bench/bench_util.h"
+#include "bench/alloc_counter.h"
+#include "list/DLinkedList.h"
+#include "heap/Heap.h"
+#include "hash/xMap.h"
+#include "util/MemoryResource.h"
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  HASH MAP BUILD WORKLOAD  ///////////////////
+//////////////////////////////////////////////////////////////////////
+
+static int intHash(int &key, int capacity)
+{
+    return (unsigned)key % capacity;
+}
+
+/*
+ * buildMap: put n keys, look each one up, destroy the map;
+ *      report the time and the allocations reaching new/delete
+ */
+static long long buildMap(const string &name, long long n, pmr::memory_resource *resource)
+{
+    AllocCounter::reset();
+    long long checksum = 0;
+    Stopwatch watch;
+    {
+        xMap<int, int> map(intHash, 0.75f, 0, 0, 0, 0, resource);
+        for (long long i = 0; i < n; i++)
+            map.put((int)(i * 7919), (int)i);
+        for (long long i = 0; i < n; i++)
+            checksum += map.get((int)(i * 7919));
+    }
+    benchReport(name, n, watch.elapsedMs());
+    cout << "    allocations: " << AllocCounter::allocations() << endl;
+    return checksum;
+}
+
+//////////////////////////////////////////////////////////////////////
+////////////////////////  LIST CHURN WORKLOAD  ///////////////////////
+//////////////////////////////////////////////////////////////////////
+
+/*
+ * churnList: a queue of 1000 items, n times: add at the back, remove the front
+ */
+static long long churnList(const string &name, long long n, pmr::memory_resource *resource)
+{
+    AllocCounter::reset();
+    long long checksum = 0;
+    Stopwatch watch;
+    {
+        DLinkedList<int> list(0, 0, resource);
+        for (int i = 0; i < 1000; i++)
+            list.add(i);
+        for (long long i = 0; i < n; i++)
+        {
+            list.add((int)i);
+            checksum += list.removeAt(0);
+        }
+    }
+    benchReport(name, n, watch.elapsedMs());
+    cout << "    allocations: " << AllocCounter::allocations() << endl;
+    return checksum;
+}
+
+/*
+ * pushPop: heaps built and drained many times (query-sized, 1000 items)
+ */
+static long long pushPop(const string &name, long long n, pmr::memory_resource *resource)
+{
+    AllocCounter::reset();
+    long long checksum = 0;
+    Stopwatch watch;
+    for (long long round = 0; round < n / 1000; round++)
+    {
+        Heap<int> heap(0, 0, resource);
+        for (int i = 0; i < 1000; i++)
+            heap.push((i * 7919) % 1000);
+        checksum += heap.pop();
+    }
+    benchReport(name, n, watch.elapsedMs());
+    cout << "    allocations: " << AllocCounter::allocations() << endl;
+    return checksum;
+}
+
+void benchMemoryResources(long long n)
+{
+    cout << "xMap build of " << n << " keys, DLinkedList churn and Heap builds of " << n << " items" << endl;
+    long long expected = buildMap("xMap, new/delete", n, 0);
+    long long checksum;
+    {
+        pmr::unsynchronized_pool_resource pool;
+        checksum = buildMap("xMap, unsynchronized_pool_resource", n, &pool);
+    }
+    {
+        PoolResource pool;
+        checksum += buildMap("xMap, PoolResource", n, &pool);
+    }
+    {
+        pmr::monotonic_buffer_resource arena;
+        checksum += buildMap("xMap, monotonic_buffer_resource", n, &arena);
+        cout << "    peak: " << AllocCounter::peakBytes() / 1024 << " KB (nothing is freed before the end: old tables kept)" << endl;
+    }
+    if (checksum != 3 * expected)
+        cout << "  MISMATCH: " << checksum << " " << 3 * expected << endl;
+
+    expected = churnList("DLinkedList churn, new/delete", n, 0);
+    {
+        pmr::unsynchronized_pool_resource pool;
+        checksum = churnList("DLinkedList churn, unsynchronized_pool_resource", n, &pool);
+    }
+    {
+        PoolResource pool;
+        checksum += churnList("DLinkedList churn, PoolResource", n, &pool);
+    }
+    if (checksum != 2 * expected)
+        cout << "  MISMATCH: " << checksum << " " << 2 * expected << endl;
+
+    expected = pushPop("Heap build, new/delete", n, 0);
+    {
+        pmr::monotonic_buffer_resource arena;
+        checksum = pushPop("Heap build, monotonic_buffer_resource", n, &arena);
+    }
+    if (checksum != expected)
+        cout << "  MISMATCH: " << checksum << " " << expected << endl;
+}
@@ -0,0 +1,72 @@
+/*
+ * Benchmarks: build with bench.sh
+ *      ./bench                 : run all benchmarks with their default size
+ *      ./bench <name>          : run one benchmark with its default size
+ *      ./bench <name> <size>   : run one benchmark with the given size
+ */
+
+#include <iostream>
+#include <string>
+#include "bench/bench_heap.h"
+#include "bench/bench_list.h"
+#include "bench/bench_memory.h"
+
+using namespace std;
+
+struct BenchCase
+{
+    string name;
+    void (*run)(long long n);
+    long long defaultSize;
+};
+
+BenchCase benches[] = {
+    {"heap_dijkstra", benchHeapDijkstra, 1000000},
+    {"heap_bulk_build", benchHeapBulkBuild, 10000000},
+    {"heap_topk", benchHeapTopK, 100000000},
+    {"heap_kway_merge", benchHeapKWayMerge, 10000000},
+    {"heap_sort", benchHeapSort, 10000000},
+    {"heap_multiqueue", benchHeapMultiQueue, 10000000},
+    {"heap_meld", benchHeapMeld, 1000000},
+    {"heap_block_layout", benchHeapBlockLayout, 100000000},
+    {"heap_external", benchHeapExternal, 20000000},
+    {"heap_timers", benchHeapTimers, 10000000},
+    {"heap_sorted_view", benchHeapSortedView, 10000000},
+    {"list_segmented_append", benchListSegmentedAppend, 50000000},
+    {"list_bulk_ops", benchListBulkOps, 2000000},
+    {"list_simd_search", benchListSimdSearch, 100000000},
+    {"list_small_alloc", benchListSmallAlloc, 1000000},
+    {"list_sort", benchListSort, 10000000},
+    {"list_algo_scaling", benchListAlgoScaling, 10000000},
+    {"list_gap_edits", benchListGapEdits, 1000000},
+    {"list_concurrent_append", benchListConcurrentAppend, 10000000},
+    {"list_snapshots", benchListSnapshots, 5000},
+    {"list_packed", benchListPacked, 100000000},
+    {"memory_resources", benchMemoryResources, 2000000},
+};
+
+int main(int argc, char **argv)
+{
+    int n = sizeof(benches) / sizeof(benches[0]);
+    string name = argc > 1 ? argv[1] : "all";
+    bool found = false;
+    for (int i = 0; i < n; ++i)
+    {
+        if (name != "all" && name != benches[i].name)
+            continue;
+        found = true;
+        long long size = argc > 2 ? stoll(argv[2]) : benches[i].defaultSize;
+        cout << "[" << benches[i].name << "]" << endl;
+        benches[i].run(size);
+    }
+    if (!found)
+    {
+        cout << "Unknown benchmark: " << name << endl;
+        cout << "Available:";
+        for (int i = 0; i < n; ++i)
+            cout << " " << benches[i].name;
+        cout << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -9,6 +9,25 @@ All in one
 #include <sstream>
 #include <string>
 #include "heap/Heap.h"
+#include "heap/IndexedHeap.h"
+#include "heap/MinMaxHeap.h"
+#include "heap/TopK.h"
+#include "heap/KWayMerger.h"
+#include "heap/MultiQueue.h"
+#include "heap/RadixHeap.h"
+#include "heap/PairingHeap.h"
+#include "heap/BlockHeap.h"
+#include "heap/ExternalHeap.h"
+#include "heap/TimerScheduler.h"
+#include "list/SegmentedList.h"
+#include "list/SmallList.h"
+#include "list/ListAlgo.h"
+#include "list/GapList.h"
+#include "list/ConcurrentAppendList.h"
+#include "list/CowArrayList.h"
+#include "list/PackedList.h"
+#include "util/MemoryResource.h"
+#include <thread>
 #include "hash/xMap.h"
 #include "app/inventory_compressor.h"
 
@@ -1053,7 +1072,7 @@ void heap065() {
 }
 
 void heap066() {
-    expect = "[1, 5, 3, 7, 10]\n[1, 3, 3, 7, 10]\n[1, 3, 5, 7, 10]\n[1, 3, 5, 7, 10]\n[1, 3, 5, 7, 10]\n[1, 3, 5, 7, 10]\n";
+    expect = "[1, 3, 5, 7, 10]\n";
     Heap<int> heap;
     XArrayList<int> arr;
     arr.add(1);
@@ -1066,7 +1085,7 @@ void heap066() {
 }
 
 void heap067() {
-    expect = "[1, 5, 3, 7, 10]\n[1, 3, 3, 7, 10]\n[1, 3, 5, 7, 10]\n[1, 3, 5, 7, 10]\n[1, 3, 5, 7, 10]\n[1, 3, 5, 7, 10]\n";
+    expect = "[1, 3, 5, 7, 10]\n";
     Heap<int> heap;
     heap.push(2);
     heap.push(4); // erase them
@@ -1472,6 +1491,835 @@ void compressor090() {
     cout << AttributeOutput.toString() << ": " << name << endl;
 }
 
+// IndexedHeap ================================================
+
+void heap091() {
+    expect = "[(2,10),(0,50),(1,30)]\n[(1,5),(2,10)]\n1 0\n1 2\n";
+    IndexedHeap<int> heap;
+    heap.push(0, 50);
+    heap.push(1, 30);
+    heap.push(2, 10);
+    heap.println();
+    heap.update(1, 5); // decrease-key
+    heap.erase(0);
+    heap.println();
+    cout << heap.contains(2) << " " << heap.contains(0) << endl;
+    cout << heap.popKey() << " " << heap.peekKey() << endl;
+}
+
+void heap092() {
+    expect = "Key is already in the heap.\nKey is not in the heap.\n100 7 3\nKey is too large for an IndexedHeap. 1\n";
+    IndexedHeap<int> heap([](int& a, int& b) { return b - a; });
+    heap.push(7, 3);
+    try {
+        heap.push(7, 4);
+    }
+    catch (invalid_argument& e) {
+        cout << e.what() << endl;
+    }
+    try {
+        heap.update(8, 1);
+    }
+    catch (out_of_range& e) {
+        cout << e.what() << endl;
+    }
+    heap.push(100, 9); // key beyond the initial capacity
+    cout << heap.popKey() << " " << heap.peekKey() << " " << heap.get(7) << endl;
+    try {
+        heap.push(IndexedHeap<int>::MAX_KEY, 1);
+    }
+    catch (length_error& e) {
+        cout << e.what() << " " << heap.size() << endl;
+    }
+}
+
+void heap093() {
+    expect = "[a,b,c,d,e,f,g,h,i,j,k,l]\n15 a\n";
+    Heap<string> heap;
+    string letters = "lkjihgfedcba";
+    for (char c : letters) heap.push(string(1, c)); // grows past the initial capacity
+    heap.emplace(3, 'z');
+    string moved = "yy";
+    heap.push(std::move(moved));
+    heap.emplace("x");
+    XArrayList<string> sorted;
+    while (heap.size() > 3) sorted.add(heap.pop());
+    cout << "[";
+    for (int i = 0; i < sorted.size(); ++i) cout << (i ? "," : "") << sorted.get(i);
+    cout << "]" << endl;
+    heap.reserve(15);
+    cout << heap.getCapacity() << " " << sorted.get(0) << endl;
+}
+
+// XArrayList ================================================
+
+void xarraylist094() {
+    expect = "[abc, x, pp, q]\n100 4\n";
+    XArrayList<string> list;
+    list.reserve(100);
+    list.emplace("abc");
+    list.emplace(2, 'p');
+    string q = "q";
+    list.add(std::move(q));
+    list.add(1, "x");
+    list.println();
+    cout << list.getCapacity() << " " << list.size() << endl;
+}
+
+void heap095() {
+    expect = "[1,2,3,4,5,6,7,8,9,10,11,12,13]\n[0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19]\n";
+    Heap<int> heap;
+    heap.push(7);
+    heap.push(3);
+    heap.push(11);
+    int batch[] = { 13, 1, 9, 5, 12, 2, 8, 4, 10, 6 }; // large batch: rebuild
+    heap.pushAll(batch, 10);
+    XArrayList<int> sorted;
+    while (!heap.empty()) sorted.add(heap.pop());
+    cout << "[";
+    for (int i = 0; i < sorted.size(); ++i) cout << (i ? "," : "") << sorted.get(i);
+    cout << "]" << endl;
+
+    XArrayList<int> items;
+    for (int i = 19; i >= 2; --i) items.add(i);
+    heap.pushAll(items);
+    int small[] = { 1, 0 }; // small batch: reheapUp
+    heap.pushAll(small, 2);
+    cout << "[";
+    for (int i = 0; !heap.empty(); ++i) cout << (i ? "," : "") << heap.pop();
+    cout << "]" << endl;
+}
+
+// MinMaxHeap ================================================
+
+void heap096() {
+    expect = "[1,50,40,8,6,10,30,20]\n1 50\n50 40 1 6\n[8,20,30,10]\n";
+    MinMaxHeap<int> heap;
+    int arr[] = { 20, 6, 10, 50, 1, 40, 30, 8 };
+    for (int i = 0; i < 8; ++i) heap.push(arr[i]);
+    heap.println();
+    cout << heap.peekMin() << " " << heap.peekMax() << endl;
+    cout << heap.popMax() << " " << heap.popMax() << " ";
+    cout << heap.popMin() << " " << heap.popMin() << endl;
+    heap.println();
+}
+
+void heap097() {
+    expect = "9 0\n[9,8,7]\nCalling to peek with the empty heap.";
+    // bounded retention: keep the 3 largest items seen so far
+    MinMaxHeap<int> heap([](int& a, int& b) { return b - a; }); // reversed: "min" end is the largest
+    for (int i = 0; i < 10; ++i) {
+        heap.push(i);
+        if (heap.size() > 3) heap.popMax(); // drop the smallest
+    }
+    MinMaxHeap<int> all;
+    int arr[] = { 5, 9, 0, 3 };
+    all.heapify(arr, 4);
+    cout << all.peekMax() << " " << all.peekMin() << endl;
+    cout << "[" << heap.popMin() << "," << heap.popMin() << "," << heap.popMin() << "]" << endl;
+    try {
+        heap.popMax();
+    }
+    catch (underflow_error& e) {
+        cout << e.what();
+    }
+}
+
+// TopK ================================================
+
+void heap098() {
+    expect = "[100, 98, 97]\n[1, 2, 3, 5]\n1 97\n";
+    TopK<int> largest(3, [](int& a, int& b) { return b - a; });
+    TopK<int> smallest(4);
+    int arr[] = { 5, 97, 3, 42, 100, 1, 98, 2, 60 };
+    for (int i = 0; i < 9; ++i) {
+        largest.offer(arr[i]);
+        smallest.offer(arr[i]);
+    }
+    largest.println();
+    smallest.println();
+    cout << largest.offer(95) + largest.offer(97) + smallest.offer(4) << " " << largest.worst() << endl;
+}
+
+void heap099() {
+    expect = "[30, 21, 20, 11]\n4 4\n";
+    // partial results, e.g. computed by two threads
+    TopK<int> part1(4, [](int& a, int& b) { return b - a; });
+    TopK<int> part2(4, [](int& a, int& b) { return b - a; });
+    int arr1[] = { 10, 20, 30, 1, 2 };
+    int arr2[] = { 11, 21, 3, 4 };
+    part1.offerAll(arr1, 5);
+    part2.offerAll(arr2, 4);
+    part1.merge(part2);
+    part1.println();
+    cout << part1.size() << " " << part1.getK() << endl;
+}
+
+// KWayMerger ================================================
+
+void heap100() {
+    expect = "[1, 2, 3, 4, 5, 6, 7, 8, 9, 10]\n";
+    XArrayList<int> run1;
+    run1.add(1);
+    run1.add(4);
+    run1.add(9);
+    DLinkedList<int> run2;
+    run2.add(2);
+    run2.add(3);
+    run2.add(10);
+    int run3[] = { 5, 6, 7, 8 };
+    XArrayList<int> empty;
+    KWayMerger<int> merger;
+    merger.addRun(run1);
+    merger.addRun(run2);
+    merger.addRun(empty);
+    merger.addRun(run3, 4);
+    XArrayList<int> output;
+    merger.mergeTo(output);
+    output.println();
+}
+
+void heap101() {
+    expect = "9 4 (b, 2) (a, 2) (c, 1) 3\nCalling to next with no item left.";
+    // descending runs, equal keys keep the order of the runs
+    pair<char, int> run1[] = { {'b', 2}, {'c', 1} };
+    pair<char, int> run2[] = { {'a', 2} };
+    KWayMerger<pair<char, int>> merger([](pair<char, int>& a, pair<char, int>& b) { return b.second - a.second; });
+    merger.addRun(run1, 2);
+    merger.addRun(run2, 1);
+    int desc[] = { 9, 4 };
+    KWayMerger<int> intMerger([](int& a, int& b) { return b - a; });
+    intMerger.addRun(desc, 2);
+    cout << intMerger.next() << " " << intMerger.peek() << " ";
+    while (merger.hasNext()) cout << merger.next() << " ";
+    cout << merger.runCount() + 1 << endl;
+    intMerger.next();
+    try {
+        intMerger.next();
+    }
+    catch (underflow_error& e) {
+        cout << e.what();
+    }
+}
+
+void heap102() {
+    expect = "[7, 5, 3, 1, 10]\n[5, 1, 3, 7, 10]\n[3, 1, 5, 7, 10]\n[1, 3, 5, 7, 10]\n[10, 7, 5, 3, 1]\n";
+    Heap<int> maxHeap([](int& a, int& b) { return b - a; });
+    XArrayList<int> arr;
+    arr.add(1);
+    arr.add(5);
+    arr.add(3);
+    arr.add(7);
+    arr.add(10);
+    maxHeap.heapsort(arr, [](XArrayList<int>& list) { list.println(); }); // trace every step
+}
+
+void heap103() {
+    expect = "4\n10 55 1\n0\n1\n[1, 2, 9, 10]\n100 1 1\n";
+    MultiQueue<int> queue(2); // 2 threads x 2 heaps
+    cout << queue.shardCount() << endl;
+    for (int i = 1; i <= 10; i++)
+        queue.push(i);
+    int item, popped = 0, sum = 0;
+    while (queue.tryPop(item)) {
+        popped++;
+        sum += item;
+    }
+    cout << popped << " " << sum << " " << queue.empty() << endl;
+    cout << queue.size() << endl;
+
+    MultiQueue<int> maxQueue(1, [](int& a, int& b) { return b - a; }, 1); // 2 heaps
+    maxQueue.push(1);
+    maxQueue.push(9);
+    maxQueue.push(2);
+    maxQueue.push(10);
+    XArrayList<int> out;
+    while (maxQueue.tryPop(item))
+        out.add(item);
+    cout << out.contains(10) << endl;
+    Heap<int> sorter;
+    sorter.heapsort(out);
+    out.println();
+
+    MultiQueue<int> sampled(2);
+    sampled.sampleRankError(1); // every pop
+    for (int i = 0; i < 100; i++)
+        sampled.push(i);
+    while (sampled.tryPop(item))
+        ;
+    cout << sampled.rankSamples() << " " << (sampled.maxRankError() < 100) << " "
+         << (sampled.meanRankError() <= sampled.maxRankError()) << endl;
+}
+
+void heap104() {
+    expect = "3 c\n5 e 3\n1\n5 b\n8 h\n0\n10 5 4 d e\n";
+    RadixHeap<unsigned int, string> heap;
+    heap.push(5, "e");
+    heap.push(3, "c");
+    heap.push(8, "h");
+    heap.push(7, "g");
+    cout << heap.peekKey() << " " << heap.pop() << endl;
+    heap.push(5, "b"); // monotone: 5 >= 3
+    cout << heap.peekKey() << " " << heap.pop() << " " << heap.size() << endl;
+    try {
+        heap.push(4, "d"); // 4 < 5: rejected
+    }
+    catch (std::invalid_argument& e) {
+        cout << 1 << endl;
+    }
+    cout << heap.peekKey() << " " << heap.pop() << endl;
+    heap.popKey();
+    cout << heap.peekKey() << " " << heap.pop() << endl;
+    cout << heap.size() << endl;
+
+    RadixHeap<unsigned int, string> fresh; // a peek does not move the bound
+    fresh.push(10, "j");
+    cout << fresh.peekKey() << " ";
+    fresh.push(5, "e");
+    fresh.push(3, "c");
+    fresh.pop();
+    cout << fresh.peekKey() << " ";
+    fresh.push(4, "d"); // 4 >= 3, the last popped key
+    cout << fresh.peekKey() << " " << fresh.pop() << " " << fresh.pop() << endl;
+}
+
+void heap105() {
+    expect = "1\n8 0\n1 2 3 4 5 7 8 9 \n0\n";
+    PairingHeap<int> heap1, heap2;
+    int array1[] = {5, 3, 9, 1};
+    int array2[] = {8, 2, 7, 4, 6};
+    heap1.heapify(array1, 4);
+    heap2.heapify(array2, 5);
+    cout << heap1.peek() << endl;
+    heap1.meld(heap2); // O(1): heap2 becomes empty
+    heap1.remove(6);
+    cout << heap1.size() << " " << heap2.size() << endl;
+    while (!heap1.empty())
+        cout << heap1.pop() << " ";
+    cout << endl;
+    cout << heap1.contains(6) << endl;
+}
+
+void heap106() {
+    expect = "[9,7,5,3,1]\n9 11\n7 5 4 3 3 2 1 1 \n";
+    PairingHeap<int> maxHeap([](int& a, int& b) { return b - a; });
+    for (int i = 1; i <= 9; i += 2)
+        maxHeap.push(i);
+    maxHeap.println(); // pre-order
+    PairingHeap<int> other(maxHeap); // copy, then meld the copy
+    other.push(2);
+    other.push(4);
+    other.pop();
+    maxHeap.meld(other);
+    cout << maxHeap.peek() << " " << maxHeap.size() << endl;
+    maxHeap.remove(7);
+    maxHeap.remove(5);
+    maxHeap.pop();
+    while (!maxHeap.empty())
+        cout << maxHeap.pop() << " ";
+    cout << endl;
+}
+
+void heap107() {
+    expect = "4\n1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 \n[2,3,6,4,5,7]\n0 1\n";
+    BlockHeap<int> heap(0, 0, 4 * sizeof(int)); // 4 slots a page: many pages
+    cout << heap.getPageSize() << endl;
+    int array[] = {14, 3, 19, 8, 1, 20, 11, 6, 16, 9, 2, 13, 18, 5, 10, 17, 7, 12, 4, 15};
+    for (int i = 0; i < 20; i++)
+        heap.push(array[i]);
+    while (!heap.empty())
+        cout << heap.pop() << " ";
+    cout << endl;
+
+    int small[] = {7, 4, 6, 2, 5, 3, 1};
+    heap.heapify(small, 7);
+    heap.remove(1);
+    heap.println();
+    cout << heap.contains(1) << " " << heap.contains(7) << endl;
+}
+
+void heap108() {
+    expect = "1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 \n4 1\n0 0\n";
+    ExternalHeap<int> heap(0, 4, 2, 3); // 4 items in memory, 2-item buffers, compaction above 3 runs
+    int array[] = {14, 3, 19, 8, 1, 20, 11, 6, 16, 9, 2, 13, 18, 5, 10, 17, 7, 12, 4, 15};
+    for (int i = 0; i < 20; i++)
+        heap.push(array[i]);
+    while (!heap.empty())
+        cout << heap.pop() << " ";
+    cout << endl;
+    ExternalHeap<int>::IOStats& stats = heap.getStats();
+    cout << stats.spills << " " << stats.compactions << endl;
+    cout << stats.itemsWritten - stats.itemsRead << " " << heap.size() << endl;
+}
+
+void heap109() {
+    expect = "9 7 8 10\n[9, 8, 7, 6, 5, 4, 3, 2, 1, 0]\n";
+    ExternalHeap<int> maxHeap([](int& a, int& b) { return b - a; }, 3, 1);
+    for (int i = 0; i < 5; i++)
+        maxHeap.push(i * 2 + 1); // 1 3 5 7 9: spilled from the 4th push
+    cout << maxHeap.pop() << " ";
+    cout << maxHeap.pop() << " ";
+    maxHeap.push(8);
+    cout << maxHeap.peek() << " ";
+    maxHeap.pop();
+    maxHeap.push(9);
+    maxHeap.push(7);
+    for (int i = 0; i <= 6; i += 2)
+        maxHeap.push(i);
+    maxHeap.push(8);
+    cout << maxHeap.size() << endl;
+    XArrayList<int> out;
+    while (!maxHeap.empty())
+        out.add(maxHeap.pop());
+    out.println();
+}
+
+void heap110() {
+    expect = "[12, 11]\n1 0 1\n[13, 16, 14]\n0 1\n[10, 15]\n0\n";
+    TimerScheduler<int> timers;
+    XArrayList<int> expired;
+    long long h10 = timers.schedule(1000, 10);
+    timers.schedule(5, 11);
+    timers.schedule(5, 12);
+    long long h13 = timers.schedule(300, 13);
+    long long h14 = timers.schedule(70000, 14);
+    long long h15 = timers.schedule(90000, 15);
+    timers.schedule(300, 16);
+    timers.advance(10, expired);
+    expired.println();
+    cout << timers.cancel(h15) << " " << timers.cancel(h15) << " " << timers.isScheduled(h14) << endl;
+    timers.schedule(90000, 15); // the node of h15 is reused with a new generation
+    timers.cancel(h10);
+    expired.clear();
+    timers.advance(80000, expired);
+    expired.println();
+    cout << timers.isScheduled(h13) << " " << timers.size() << endl;
+    timers.schedule(1000, 10); // not after now: expires at the next tick
+    expired.clear();
+    timers.advance(100000, expired);
+    expired.println();
+    cout << timers.size() << endl;
+}
+
+void heap111() {
+    expect = "[3, 1]\n[2]\n[5, 4]\n0 1\n1 1\n[6]\n";
+    TimerScheduler<int> timers(0, 1); // one level: 256 ticks, then the far heap
+    XArrayList<int> expired;
+    timers.schedule(100000, 4);
+    long long h = timers.schedule(5000, 9);
+    timers.schedule(300, 1);
+    timers.schedule(100, 3);
+    timers.schedule(600, 2);
+    timers.schedule(100000, 5);
+    timers.cancel(h); // far timer: cancelled lazily
+    timers.advance(500, expired);
+    expired.println();
+    expired.clear();
+    timers.advance(700, expired);
+    expired.println();
+    expired.clear();
+    timers.advance(200000, expired);
+    expired.println();
+    cout << timers.size() << " " << (timers.getNow() == 200000) << endl;
+
+    // cancel churn of far timers: the far heap keeps about the live ones only
+    timers.schedule(900000, 6);
+    for (int i = 0; i < 100000; i++)
+        timers.cancel(timers.schedule(1000000 + i, i));
+    cout << timers.size() << " " << (timers.farEntries() <= 66) << endl;
+    expired.clear();
+    timers.advance(2000000, expired);
+    expired.println();
+}
+
+void heap112() {
+    expect = "1 2 3 \n[1,3,2,7,4,5,6]\n1 2 3 4 5 6 7 \n[pear, kiwi, apple]\n0 3\n";
+    Heap<int> heap;
+    int array[] = {4, 7, 2, 1, 3, 5, 6};
+    heap.heapify(array, 7);
+    Heap<int>::SortedView view = heap.sortedView();
+    for (int i = 0; i < 3; i++)
+        cout << view.next() << " ";
+    cout << endl;
+    heap.println(); // not changed
+    Heap<int>::SortedView all = heap.sortedView();
+    while (all.hasNext())
+        cout << all.next() << " ";
+    cout << endl;
+
+    Heap<string> words([](string& a, string& b) { return b.compare(a); }); // largest first
+    words.push("kiwi");
+    words.push("apple");
+    words.push("pear");
+    XArrayList<string> out;
+    int moved = words.drainTo(out);
+    out.println();
+    cout << words.size() << " " << moved << endl;
+}
+
+void list113() {
+    expect = "1 1 100\n[0, 1, 3, 9]\n2 2 0\n6 4\n";
+    SegmentedList<int> list(0, 0, 1); // chunks of 2, 4, 8, ... items
+    for (int i = 0; i < 10; i++) list.add(i);
+    int* first = &list.get(0);
+    int* middle = &list.get(5);
+    for (int i = 10; i < 100; i++) list.add(i); // new chunks only
+    cout << (first == &list.get(0)) << " " << (middle == &list.get(5) && *middle == 5) << " " << list.size() << endl;
+
+    SegmentedList<int> small(0, 0, 1);
+    small.add(1);
+    small.add(2);
+    small.add(3);
+    small.add(0, 0);
+    small.add(4, 9);
+    int removed = small.removeAt(2);
+    small.println();
+    cout << removed << " " << small.indexOf(3) << " " << small.contains(7) << endl;
+    cout << small.getCapacity() << " " << small.size() << endl;
+}
+
+void xarraylist114() {
+    expect = "[1, 2, 3, 4, 5]\n[1, 2, 10, 20, 30, 3, 4, 5]\n[1, 2, 4, 5]\n[1, 5]\n2\n[a, ccc, dd]\n[1, 1, 5, 5]\n[x, x, y, x, y, y, x, y]\n";
+    XArrayList<int> list(0, 0, 2);
+    int items[] = {1, 2, 3, 4, 5};
+    list.addAll(items, 5);
+    list.println();
+    int more[] = {10, 20, 30};
+    list.insertRange(2, more, more + 3);
+    list.println();
+    list.removeRange(2, 6);
+    list.println();
+    int removed = list.removeIf([](int& item) { return item % 2 == 0 || item == 4; });
+    list.println();
+    cout << removed << endl;
+
+    XArrayList<string> words;
+    string w[] = {"a", "bb", "ccc", "dd"};
+    words.addAll(w, 4);
+    words.removeIf([](string& item) { return item == "bb"; });
+    words.println();
+
+    // ranges taken from the list itself, with and without growing the array
+    list.insertRange(1, list.begin(), list.end());
+    list.println();
+    XArrayList<string> self(0, 0, 3);
+    self.add("x");
+    self.add("y");
+    self.addAll(self.getData(), self.size());
+    self.insertRange(1, self.begin(), self.end());
+    self.println();
+}
+
+void xarraylist115() {
+    expect = "37 -1 1\n20 -1\n3 0\n2\n";
+    XArrayList<int> numbers;
+    for (int i = 0; i < 100; i++) numbers.add(i * 3 % 101);
+    cout << numbers.indexOf(10) << " " << numbers.indexOf(1000) << " " << numbers.contains(99) << endl;
+
+    XArrayList<char> letters;
+    string text = "the quick brown fox jumps over the lazy dog";
+    for (char c : text) letters.add(c);
+    cout << letters.indexOf('j') << " " << letters.indexOf('!') << endl;
+
+    XArrayList<double> values;
+    for (int i = 0; i < 9; i++) values.add(i * 0.5);
+    cout << values.indexOf(1.5) << " " << values.contains(0.25) << endl;
+
+    // a custom itemEqual still decides equality
+    XArrayList<int> byParity(0, [](int& a, int& b) { return a % 2 == b % 2; });
+    byParity.add(4);
+    byParity.add(8);
+    byParity.add(5);
+    cout << byParity.indexOf(7) << endl;
+}
+
+void list116() {
+    expect = "[a, b, c] 1 3\n[a, x, b, c, d] 0 6\n[a, b, c] 1\n[1, 2, 7]\nout of range 3\n";
+    SmallList<string, 3> list;
+    list.add("a");
+    list.add("c");
+    list.add(1, "b");
+    cout << list.toString() << " " << list.isInline() << " " << list.getCapacity() << endl;
+    SmallList<string, 3> copy(list);
+    list.add("d"); // spills to the heap
+    list.add(1, "x");
+    cout << list.toString() << " " << list.isInline() << " " << list.getCapacity() << endl;
+    cout << copy.toString() << " " << copy.isInline() << endl;
+
+    SmallList<int, 2> numbers;
+    numbers.set(0, 1);
+    numbers.set(1, 2);
+    numbers.set(2, 7);
+    numbers.println();
+    try {
+        numbers.set(5, 9); // only index == size() appends
+    }
+    catch (const out_of_range &e) {
+        cout << "out of range " << numbers.size() << endl;
+    }
+}
+
+void xarraylist117() {
+    expect = "[1, 2, 3, 5, 8, 9]\n3 1\n28 9\n[9, 8, 5, 3, 2, 1]\n[1, 3, 5, 9]\n[(a, 1), (c, 1), (b, 2), (d, 2)]\n";
+    XArrayList<int> list;
+    int items[] = {5, 3, 9, 1, 8, 2};
+    list.addAll(items, 6);
+    std::sort(list.begin(), list.end());
+    list.println();
+    XArrayList<int>::Iterator found = std::lower_bound(list.begin(), list.end(), 5);
+    cout << (found - list.begin()) << " " << (found < list.end()) << endl;
+
+    const XArrayList<int>& view = list;
+    int sum = 0;
+    for (XArrayList<int>::ConstIterator it = view.begin(); it != view.end(); ++it) sum += *it;
+    cout << sum << " " << list.end()[-1] << endl;
+
+    list.sort([](int& a, int& b) { return b - a; });
+    list.println();
+    list.sort(0); // the comparator overload, not an execution policy
+    for (XArrayList<int>::Iterator it = list.begin(); it != list.end(); it++)
+        if (*it % 2 == 0) it.remove();
+    list.println();
+
+    XArrayList<pair<char, int>> pairs;
+    pairs.add(make_pair('b', 2));
+    pairs.add(make_pair('a', 1));
+    pairs.add(make_pair('d', 2));
+    pairs.add(make_pair('c', 1));
+    pairs.stableSort([](pair<char, int>& a, pair<char, int>& b) { return a.second - b.second; });
+    // equal seconds keep their order
+    cout << pairs.toString() << endl;
+}
+
+void listalgo118() {
+    expect = "[-7, -1, 0, 3, 3, 12, 40]\n[-2.5, -0, 0.5, 8]\n1 1\n[(a, 1), (c, 1), (b, 2), (d, 2)]\n3 -1 1 5\n";
+    XArrayList<int> numbers;
+    int items[] = {12, -1, 3, 40, -7, 3, 0};
+    numbers.addAll(items, 7);
+    radixSort(numbers);
+    numbers.println();
+    XArrayList<double> values;
+    double reals[] = {0.5, -0.0, 8.0, -2.5};
+    values.addAll(reals, 4);
+    radixSort(values, 2);
+    values.println();
+
+    XArrayList<int> many;
+    for (int i = 0; i < 5000; i++) many.add((i * 7919) % 5000);
+    parallelMergeSort(many, 0, 3);
+    cout << std::is_sorted(many.begin(), many.end()) << " " << (many.get(4999) == 4999) << endl;
+
+    XArrayList<pair<char, int>> pairs;
+    pairs.add(make_pair('b', 2));
+    pairs.add(make_pair('a', 1));
+    pairs.add(make_pair('d', 2));
+    pairs.add(make_pair('c', 1));
+    parallelMergeSort(pairs, [](pair<char, int>& a, pair<char, int>& b) { return a.second - b.second; });
+    cout << pairs.toString() << endl;
+
+    DLinkedList<int> linked;
+    for (int i = 0; i < numbers.size(); i++) linked.add(numbers.get(i));
+    cout << lowerBound(numbers, 3) << " " << binarySearch(numbers, 5) << " "
+         << binarySearch(linked, -1) << " " << lowerBound(linked, 4) << endl;
+}
+
+void list119() {
+    expect = "[a, b, x, y, c, d]\n4\n[a, b, x, c]\nd 2 1\n[a, z, b, x, c] 2\n[a, z, b, x, c, e]\n";
+    GapList<string> list(0, 0, 2);
+    list.add("a");
+    list.add("b");
+    list.add("c");
+    list.add("d");
+    list.add(2, "x");
+    list.add(3, "y"); // next to the last edit: no shift
+    list.println();
+    cout << list.getGapIndex() << endl;
+    string removed = list.removeAt(5);
+    list.removeAt(3);
+    list.set(3, "c");
+    cout << list.toString() << endl;
+    cout << removed << " " << list.indexOf("x") << " " << list.contains("b") << endl;
+    list.add(1, "z");
+    cout << list.toString() << " " << list.getGapIndex() << endl;
+    list.set(list.size(), "e"); // index == size(): appends
+    cout << list.toString() << endl;
+}
+
+void list120() {
+    expect = "4000 1 1\n16 16 1\n4000 4\n0\n2 20 [0, 10]\n10 09 1\n";
+    ConcurrentAppendList<int> list(16);
+    thread writers[4];
+    for (int t = 0; t < 4; t++)
+        writers[t] = thread([&list, t]()
+                            { for (int i = 0; i < 1000; i++) list.add(t * 1000 + i); });
+    for (int t = 0; t < 4; t++)
+        writers[t].join();
+    long long sum = 0;
+    for (long long idx = 0; idx < list.size(); idx++)
+        sum += list.get(idx);
+    cout << list.size() << " " << (sum == 3999LL * 4000 / 2) << " " << (list.segmentCount() > 1) << endl;
+
+    // 16 items: they fit in the first segment, the array is handed over
+    ConcurrentAppendList<int> small(16);
+    for (int i = 0; i < 16; i++)
+        small.add(i);
+    XArrayList<int> moved;
+    small.moveTo(moved);
+    cout << moved.size() << " " << moved.getCapacity() << " " << small.empty() << endl;
+
+    XArrayList<int> all;
+    list.moveTo(all);
+    int inOrder = 0;
+    for (int t = 0; t < 4; t++)
+    {
+        int last = -1;
+        bool ordered = true;
+        for (int idx = 0; idx < all.size(); idx++)
+            if (all.get(idx) / 1000 == t)
+            {
+                ordered = ordered && all.get(idx) > last;
+                last = all.get(idx);
+            }
+        inOrder += ordered;
+    }
+    cout << all.size() << " " << inOrder << endl; // each thread: its items in order
+    cout << list.size() << endl;
+    list.add(0);
+    list.add(10);
+    try {
+        list.get(2);
+    }
+    catch (const out_of_range &e) {
+        cout << list.size() << " " << list.get(1) * 2 << " ";
+    }
+    list.moveTo(all);
+    cout << all.toString() << endl;
+
+    // a list with a memory resource cannot adopt the array: items moved one by one
+    PoolResource pool;
+    ConcurrentAppendList<string> words(4);
+    for (int i = 0; i < 10; i++)
+        words.add(to_string(i));
+    XArrayList<string> pooled(0, 0, 2, &pool);
+    pooled.add("old");
+    words.moveTo(pooled);
+    cout << pooled.size() << " " << pooled.get(0) << pooled.get(9) << " " << words.empty() << endl;
+}
+
+void list121() {
+    expect = "[1, 2, 3] 1 1\n[1, 2, 3] [1, 20, 3, 4] 0 0\n2 -1 [20, 3, 4]\nout of range 0\n30 20 0\n[a, b] [a, c] 0\n";
+    CowArrayList<int> list;
+    list.add(1);
+    list.add(2);
+    list.add(3);
+    CowArrayList<int> snapshot(list);
+    cout << snapshot.toString() << " " << list.isShared() << " " << snapshot.isShared() << endl;
+    list.set(1, 20); // list copies its items, snapshot keeps the old ones
+    list.add(4);
+    cout << snapshot.toString() << " " << list.toString() << " "
+         << list.isShared() << " " << snapshot.isShared() << endl;
+    CowArrayList<int> other;
+    other = list;
+    other.removeAt(0);
+    cout << snapshot.read(1) << " " << other.indexOf(1) << " " << other.toString() << endl;
+    CowArrayList<int> empty;
+    try {
+        empty.set(3, 7);
+    }
+    catch (const out_of_range &e) {
+        cout << "out of range " << empty.size() << endl;
+    }
+    int &first = other.get(0); // other's array becomes unshareable
+    CowArrayList<int> later(other);
+    first = 30;
+    cout << other.read(0) << " " << later.read(0) << " " << later.isShared() << endl;
+
+    List1D<string> row;
+    row.add("a");
+    row.add("b");
+    List1D<string> copy = row;
+    copy.set(1, "c");
+    cout << row << " " << copy << " " << (row.get(1) == copy.get(1)) << endl;
+}
+
+void list122() {
+    expect = "[1, 0, 3, 2, 3] 2 3\n[1, 3, 3] 1\n70 2 36 3\n-1 3 [2, 2, 1, 1, 1] 8\nout of range 0\n";
+    PackedList<2> values;
+    values.add(1);
+    values.add(3);
+    values.add(2);
+    values.add(3);
+    values.add(1, 0);
+    cout << values.toString() << " " << values.count(3) << " " << values.get(4) << endl;
+    values.removeAt(1);
+    values.removeItem(2);
+    cout << values.toString() << " " << values.indexOf(3) << endl;
+
+    PackedList<1> flags;
+    flags.fill(0, 70, 1); // two words
+    flags.set(3, 0);
+    flags.set(68, 0);
+    cout << flags.size() << " " << flags.count(0) << " "
+         << flags.countRange(30, 66, 1) << " " << flags.indexOf(0) << endl;
+
+    PackedList<4> small;
+    small.fill(0, 5, 1);
+    small.fill(0, 2, 2);
+    try {
+        small.add(16);
+    }
+    catch (const invalid_argument &e) {
+        cout << small.indexOf(16) << " ";
+    }
+    cout << small.count(1) << " " << small.toString() << " " << small.memoryBytes() << endl;
+    PackedList<4> empty;
+    try {
+        empty.set(3, 7);
+    }
+    catch (const out_of_range &e) {
+        cout << "out of range " << empty.size() << endl;
+    }
+}
+
+void memory123() {
+    expect = "[0, 1, 2, 3, 4] [b, c] 4 9\n5 1\n3 1\n";
+    // every byte from a fixed buffer: one more allocation would throw bad_alloc
+    static char buffer[1 << 16];
+    pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), pmr::null_memory_resource());
+    XArrayList<int> copy;
+    {
+        XArrayList<int> list(0, 0, 2, &arena);
+        for (int i = 0; i < 5; i++)
+            list.add(i);
+        DLinkedList<string> names(0, 0, &arena);
+        names.add("a");
+        names.add("b");
+        names.add("c");
+        names.removeAt(0);
+        Heap<int> heap(0, 0, &arena);
+        heap.push(4);
+        heap.push(9);
+        xMap<int, int> map(xMap<int, int>::simpleHash, 0.75f, 0, 0, 0, 0, &arena);
+        for (int i = 0; i < 20; i++)
+            map.put(i, i * i);
+        map.remove(2);
+        cout << list.toString() << " " << names.toString() << " " << heap.peek() << " " << map.get(3) << endl;
+        copy = list; // copy keeps new/delete
+    }
+    arena.release();
+    cout << copy.size() << " " << copy.contains(4) << endl;
+
+    PoolResource pool;
+    void *first = pool.allocate(24);
+    pool.deallocate(first, 24);
+    void *second = pool.allocate(20); // same size class: the freed block again
+    DLinkedList<int> queue(0, 0, &pool);
+    for (int i = 0; i < 3; i++)
+        queue.add(i);
+    cout << queue.size() << " " << (first == second) << endl;
+    pool.deallocate(second, 20);
+}
+
 void (*func_ptr[])() = {
     hash001, hash002, hash003, hash004, hash005, hash006, hash007, hash008, hash009, hash010,
     hash011, hash012, hash013, hash014, hash015, hash016, hash017, hash018, hash019, hash020,
@@ -1482,6 +2330,9 @@ void (*func_ptr[])() = {
     heap061, heap062, heap063, heap064, heap065, heap066, heap067, heap068, heap069, heap070,
     huffmantree071, huffmantree072, huffmantree073, huffmantree074, huffmantree075, huffmantree076, huffmantree077, huffmantree078, huffmantree079, huffmantree080,
     compressor081, compressor082, compressor083, compressor084, compressor085, compressor086, compressor087, compressor088, compressor089, compressor090,
+    heap091, heap092, heap093, xarraylist094, heap095, heap096, heap097, heap098, heap099, heap100, heap101, heap102,
+    heap103, heap104, heap105, heap106, heap107, heap108, heap109, heap110, heap111, heap112,
+    list113, xarraylist114, xarraylist115, list116, xarraylist117, listalgo118, list119, list120, list121, list122, memory123,
 };
 
 bool run(int func_idx)